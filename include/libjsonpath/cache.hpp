@@ -0,0 +1,101 @@
+#ifndef LIBJSONPATH_CACHE_H
+#define LIBJSONPATH_CACHE_H
+
+#include <cstddef>        // size_t
+#include <list>           // std::list
+#include <mutex>          // std::mutex std::lock_guard
+#include <string>         // std::string
+#include <string_view>    // std::string_view
+#include <unordered_map>  // std::unordered_map
+#include <utility>        // std::move
+
+namespace libjsonpath {
+
+// A snapshot of cache statistics.
+struct CacheInfo {
+  size_t hits;
+  size_t misses;
+  size_t evictions;
+  size_t maxsize;
+  size_t currsize;
+};
+
+// A thread-safe, fixed capacity, least recently used cache mapping strings to
+// _Value_. A capacity of zero disables caching.
+template <typename Value>
+class LRUCache {
+private:
+  using entry_t = std::pair<const std::string, Value>;
+  using list_t = std::list<entry_t>;
+
+  // Most recently used entries are at the front of the list. Map keys are
+  // views of strings owned by list entries, so lookups don't allocate.
+  list_t m_entries{};
+  std::unordered_map<std::string_view, typename list_t::iterator> m_index{};
+  size_t m_capacity;
+  size_t m_hits{0};
+  size_t m_misses{0};
+  size_t m_evictions{0};
+  mutable std::mutex m_mutex{};
+
+public:
+  explicit LRUCache(size_t capacity) : m_capacity{capacity} {}
+
+  LRUCache(const LRUCache&) = delete;
+  LRUCache& operator=(const LRUCache&) = delete;
+
+  // Return the cached value for _key_, or the result of calling _factory_
+  // if _key_ is not in the cache. _factory_ is called without holding the
+  // cache's lock, and exceptions thrown by it are not cached.
+  template <typename Factory>
+  Value get_or_insert(std::string_view key, Factory factory) {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      auto it{m_index.find(key)};
+      if (it != m_index.end()) {
+        m_hits++;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->second;
+      }
+      m_misses++;
+    }
+
+    Value value{factory()};
+    if (!m_capacity) {
+      return value;
+    }
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    // Another thread might have inserted the same key while we were
+    // unlocked. If so, keep the existing entry.
+    if (m_index.find(key) == m_index.end()) {
+      m_entries.emplace_front(std::string{key}, value);
+      m_index.emplace(m_entries.front().first, m_entries.begin());
+      while (m_entries.size() > m_capacity) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+        m_evictions++;
+      }
+    }
+    return value;
+  }
+
+  // Remove all entries and reset statistics.
+  void clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_index.clear();
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+  }
+
+  CacheInfo info() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return {m_hits, m_misses, m_evictions, m_capacity, m_entries.size()};
+  }
+};
+
+}  // namespace libjsonpath
+
+#endif
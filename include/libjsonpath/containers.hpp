@@ -0,0 +1,62 @@
+#ifndef LIBJSONPATH_CONTAINERS_H
+#define LIBJSONPATH_CONTAINERS_H
+
+#include "nanobind/nanobind.h"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+// Reading dicts and lists that other threads might be changing.
+//
+// Free-threaded builds have no GIL, so single items are fetched as new
+// references, and loops over a container's items hold a critical section on
+// the container, with nb::ft_object_guard, which is a no-op with the GIL.
+//
+// Even with the GIL, a borrowed reference to an item is only safe until the
+// next call into Python, which might remove the item from its container.
+// Filters call into Python for function extensions and `==` on other types,
+// and so does serialization with a JSON encoder, so items they use are held
+// by a strong reference first.
+
+// Return item _index_ of the list _list_, or an invalid object if _index_ is
+// out of range.
+inline nb::object list_item(PyObject* list, Py_ssize_t index) {
+#ifdef Py_GIL_DISABLED
+  PyObject* item{PyList_GetItemRef(list, index)};
+  if (!item) {
+    PyErr_Clear();
+    return {};
+  }
+  return nb::steal(item);
+#else
+  PyObject* item{PyList_GetItem(list, index)};
+  if (!item) {
+    PyErr_Clear();
+    return {};
+  }
+  return nb::borrow(item);
+#endif
+}
+
+// Return the value of _key_ in the dict _dict_, or an invalid object if
+// _dict_ doesn't have _key_.
+inline nb::object dict_item(PyObject* dict, PyObject* key) {
+#ifdef Py_GIL_DISABLED
+  PyObject* item{nullptr};
+  if (PyDict_GetItemRef(dict, key, &item) < 0) {
+    throw nb::python_error();
+  }
+  return nb::steal(item);
+#else
+  PyObject* item{PyDict_GetItemWithError(dict, key)};
+  if (!item && PyErr_Occurred()) {
+    throw nb::python_error();
+  }
+  return nb::borrow(item);
+#endif
+}
+
+}  // namespace libjsonpath
+
+#endif
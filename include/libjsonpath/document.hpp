@@ -0,0 +1,178 @@
+#ifndef LIBJSONPATH_DOCUMENT_H
+#define LIBJSONPATH_DOCUMENT_H
+
+#include <cstddef>        // size_t
+#include <cstdint>        // std::uint8_t std::uint32_t
+#include <stdexcept>      // std::runtime_error
+#include <string>         // std::string
+#include <string_view>    // std::string_view
+#include <unordered_map>  // std::unordered_map
+#include <vector>         // std::vector
+
+#include "nanobind/nanobind.h"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+// Raised when a JSONDocument is given text that isn't valid JSON.
+class JSONDecodeError : public std::runtime_error {
+public:
+  JSONDecodeError(const std::string& reason_, size_t position_)
+      : std::runtime_error(reason_ + " at position " +
+                           std::to_string(position_)),
+        reason{reason_},
+        position{position_} {}
+
+  std::string reason;
+  size_t position;
+};
+
+// JSON text parsed into a flat array of elements, in document order, without
+// creating any Python objects. Queries are evaluated over the elements and
+// only values they select are converted to Python objects, so the parts of a
+// document a query never looks at are never decoded.
+//
+// Converted values are the same as those given by Python's `json.loads`,
+// including `NaN` and `Infinity`, arbitrary precision integers, and the last
+// value for keys that appear more than once in an object.
+//
+// Parsing doesn't touch the Python interpreter, but converting values does.
+class JSONDocument {
+public:
+  enum class Type : std::uint8_t {
+    null,
+    false_,
+    true_,
+    integer,
+    real,
+    string,
+    array,
+    object,
+  };
+
+  // An array or object is followed by its items, or by a key (a string) and
+  // value for each of its members.
+  struct Element {
+    Type type;
+    // Strings: true if the string had escape sequences, and its decoded text
+    // is in m_unescaped rather than m_text. Objects: true if a key appears
+    // more than once.
+    bool flag;
+    // Strings and numbers: their length in bytes. Arrays and objects: the
+    // number of items or members.
+    std::uint32_t length;
+    // Strings and numbers: the offset of their text. Arrays and objects: the
+    // index of the first element after all of their items or members.
+    size_t offset;
+  };
+
+  // Parse UTF-8 encoded JSON _text_.
+  explicit JSONDocument(std::string text);
+
+  // Parse JSON from a Python str, or a bytes-like object holding UTF-8
+  // encoded JSON.
+  static JSONDocument from_python(nb::handle data);
+
+  // Parse _text_ after checking that it is valid UTF-8, like Python's strict
+  // UTF-8 codec would.
+  static JSONDocument from_utf8(std::string text);
+
+  static constexpr size_t root = 0;
+
+  const Element& element(size_t index) const { return m_elements[index]; }
+  Type type(size_t index) const { return m_elements[index].type; }
+
+  // Return the index of the first element after _index_ and its descendants.
+  size_t next(size_t index) const {
+    const Element& element_{m_elements[index]};
+    return element_.type == Type::array || element_.type == Type::object
+               ? element_.offset
+               : index + 1;
+  }
+
+  // Call _func_ with the key and value element of each member of the object
+  // at _index_, or with the array index and element of each item of the
+  // array at _index_, in the same order as iterating over the decoded dict or
+  // list. _func_'s third argument is true for array items.
+  template <typename Func>
+  void for_each_child(size_t index, Func&& func) const;
+
+  // Return the UTF-8 encoded, unescaped text of the string at _index_.
+  std::string_view string(size_t index) const {
+    const Element& element_{m_elements[index]};
+    return {(element_.flag ? m_unescaped.data() : m_text.data()) +
+                element_.offset,
+            element_.length};
+  }
+
+  // The text of the number at _index_.
+  std::string_view number(size_t index) const {
+    const Element& element_{m_elements[index]};
+    return {m_text.data() + element_.offset, element_.length};
+  }
+
+  size_t size() const { return m_elements.size(); }
+
+  // Convert the element at _index_, and all of its descendants, to Python
+  // objects. Descendants found in _converted_, keyed by element index, are
+  // reused instead of being converted again.
+  nb::object to_python(
+      size_t index,
+      const std::unordered_map<size_t, nb::object>* converted = nullptr) const;
+
+  // Convert the string at _index_ to a Python str.
+  nb::str to_str(size_t index) const;
+
+private:
+  std::string m_text;
+  std::string m_unescaped{};
+  std::vector<Element> m_elements{};
+
+  friend class DocumentParser;
+};
+
+template <typename Func>
+void JSONDocument::for_each_child(size_t index, Func&& func) const {
+  const Element& element_{m_elements[index]};
+  if (element_.type == Type::array) {
+    size_t i{0};
+    for (size_t item = index + 1; item < element_.offset; item = next(item)) {
+      func(i++, item, true);
+    }
+  } else if (element_.type == Type::object) {
+    for (size_t key = index + 1; key < element_.offset; key = next(key + 1)) {
+      if (!element_.flag) {
+        func(key, key + 1, false);
+        continue;
+      }
+
+      // A repeated key keeps the position of its first occurrence and the
+      // value of its last.
+      auto name{string(key)};
+      bool repeated{false};
+      for (size_t other = index + 1; other < key; other = next(other + 1)) {
+        if (string(other) == name) {
+          repeated = true;
+          break;
+        }
+      }
+      if (repeated) {
+        continue;
+      }
+
+      size_t value{key + 1};
+      for (size_t other = next(key + 1); other < element_.offset;
+           other = next(other + 1)) {
+        if (string(other) == name) {
+          value = other + 1;
+        }
+      }
+      func(key, value, false);
+    }
+  }
+}
+
+}  // namespace libjsonpath
+
+#endif
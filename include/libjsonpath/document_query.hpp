@@ -0,0 +1,64 @@
+#ifndef LIBJSONPATH_DOCUMENT_QUERY_H
+#define LIBJSONPATH_DOCUMENT_QUERY_H
+
+#include <cstddef>      // size_t
+#include <memory>       // std::shared_ptr
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+
+#include "libjsonpath/document.hpp"
+#include "libjsonpath/node.hpp"
+#include "libjsonpath/parallel.hpp"
+#include "libjsonpath/path.hpp"
+#include "nanobind/nanobind.h"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+// Queries of a JSONDocument. Segments are applied to the document's elements
+// directly, and only selected values, and candidates of filters that need
+// Python, are converted to Python objects.
+
+// Settings for evaluating wide segments in parallel, on the threads of
+// _pool_. A threshold of zero disables parallel evaluation.
+struct DocumentParallel {
+  size_t threshold;
+  ThreadPool* pool;
+};
+
+// Apply _plan_ to _doc_ and return the selected nodes.
+JSONPathNodeList query_document(const JSONDocument& doc, const QueryPlan& plan,
+                                nb::handle nothing, DocumentParallel parallel);
+
+// Apply _plan_ to _doc_ and return a list of the selected values.
+nb::list findall_document(const JSONDocument& doc, const QueryPlan& plan,
+                          nb::handle nothing, DocumentParallel parallel);
+
+// Apply _plan_ to _doc_ and return the selected values as a typed array,
+// without converting them to Python objects.
+nb::object findall_array_document(const JSONDocument& doc,
+                                  const QueryPlan& plan, nb::handle nothing,
+                                  DocumentParallel parallel,
+                                  std::string_view dtype, bool masked);
+
+// Apply _plan_ to _doc_ and return the selected values as UTF-8 encoded
+// JSON, written straight from the document.
+nb::bytes findall_json_document(const JSONDocument& doc, const QueryPlan& plan,
+                                nb::handle nothing, DocumentParallel parallel);
+
+// Like findall_json_document, but write an object with the normalized path
+// and value of each node.
+nb::bytes query_json_document(const JSONDocument& doc, const QueryPlan& plan,
+                              nb::handle nothing, DocumentParallel parallel);
+
+// Apply _plan_ to every line of the newline-delimited JSON file at _path_.
+// See NDJSONIterator.
+NDJSONIterator ndjson_iterator(const std::string& path,
+                               std::shared_ptr<const QueryPlan> plan,
+                               nb::object nothing, size_t threads,
+                               bool ordered, bool values);
+
+}  // namespace libjsonpath
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef LIBJSONPATH_FILTER_H
+#define LIBJSONPATH_FILTER_H
+
+#include <cstddef>        // size_t
+#include <cstdint>        // std::uint8_t
+#include <functional>     // std::function
+#include <memory>         // std::shared_ptr
+#include <optional>       // std::optional
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+#include <vector>         // std::vector
+
+#include "libjsonpath/iregexp.hpp"
+#include "libjsonpath/kernels.hpp"
+#include "libjsonpath/parse.hpp"
+#include "libjsonpath/selectors.hpp"
+#include "nanobind/nanobind.h"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+using function_extension_map = std::unordered_map<std::string, nb::callable>;
+
+enum class Opcode : std::uint8_t {
+  // Push literals[operand].
+  push,
+  // Push the node list from applying queries[operand] to the current node.
+  relative_query,
+  // Push the node list from applying queries[operand] to the root node.
+  root_query,
+  // Pop calls[operand]'s arguments and push its return value.
+  call,
+  // Replace a node list with one node on top of the stack with its value.
+  unpack,
+  // Replace the value on top of the stack with its truthiness.
+  truthy,
+  logical_not,
+  // If the value on top of the stack is falsy (or truthy), replace it with
+  // false (or true) and skip the next _operand_ instructions. Otherwise pop
+  // it.
+  jump_if_false,
+  jump_if_true,
+  // Pop two operands and push the result of comparing them with the
+  // BinaryOperator in operand.
+  compare,
+};
+
+struct Instruction {
+  Opcode opcode;
+  size_t operand;
+};
+
+// A query in a filter expression. When _limit_ is not zero, the expression
+// only needs the query's first _limit_ nodes, like when testing for the
+// existence of a node. Singular queries, like `@.x`, select at most one node
+// and are evaluated by looking up each name or index directly.
+struct FilterQuery {
+  const segments_t* segments;
+  size_t limit;
+  bool singular;
+};
+
+// Function extensions with a native implementation.
+enum class NativeFunction : std::uint8_t {
+  none,
+  count,
+  length,
+  value,
+  match,
+  search,
+};
+
+// Call the native implementation _kind_ instead of calling into Python when
+// a filter function is an instance of exactly _type_. Instances of
+// subclasses, and any other callable registered with the same name, are
+// still called from Python.
+void register_native_function(nb::handle type, NativeFunction kind);
+
+// A function call in a filter expression, bound to a function extension and
+// its signature when the filter is compiled. _func_ is null and _signature_
+// is empty if the function or its signature wasn't registered. _native_ is
+// set if _func_ has a native implementation.
+//
+// Native `match` and `search` calls with a string literal pattern have it
+// compiled in advance, or set to null if it is not a valid I-Regexp.
+struct BoundCall {
+  const FunctionCall* expression;
+  nb::callable func;
+  std::optional<FunctionExtensionTypes> signature;
+  NativeFunction native;
+  std::optional<std::shared_ptr<const IRegexp>> pattern{};
+};
+
+// A filter that compares the current node with a literal, like `@ > 42.5` or
+// `'abc' == @`, normalized so the current node is on the left. Only integer,
+// float and string literals are recorded.
+struct LiteralComparison {
+  BinaryOperator op;
+  ComparisonLiteral literal;
+};
+
+// A filter expression compiled to a flat program for a small stack machine.
+// Literals are built as Python objects once, and sub-expressions made only of
+// literals are evaluated at compile time.
+//
+// Programs refer to queries and function calls in the expression they were
+// compiled from, so that expression must outlive its program.
+class FilterProgram {
+public:
+  FilterProgram(const expression_t& expression,
+                const function_extension_map& functions,
+                const function_signature_map& signatures);
+
+  std::vector<Instruction> code{};
+  std::vector<nb::object> literals{};
+  std::vector<FilterQuery> queries{};
+  std::vector<BoundCall> calls{};
+
+  // Set if the whole filter is a comparison of the current node with a
+  // literal, so arrays of numbers or short strings can be filtered with a
+  // ComparisonColumn instead of running the program for each item.
+  std::optional<LiteralComparison> literal_comparison{};
+
+  // The most values the program will have on the stack at once.
+  size_t stack_size{0};
+};
+
+// Compiled programs for every filter selector in some segments, including
+// those nested in filter queries, keyed by selector. Function calls are bound
+// to _functions_ and _signatures_.
+class FilterPrograms {
+public:
+  FilterPrograms(const segments_t& segments,
+                 const function_extension_map& functions,
+                 const function_signature_map& signatures);
+  FilterPrograms(const FilterPrograms&) = delete;
+  FilterPrograms& operator=(const FilterPrograms&) = delete;
+
+  const FilterProgram& get(const FilterSelector& selector) const {
+    return m_programs.at(&selector);
+  }
+
+  bool empty() const { return m_programs.empty(); }
+
+  // Return true if any filter has a root query, like `$.x` in `@.y == $.x`.
+  bool root_queries() const { return m_root_queries; }
+
+private:
+  std::unordered_map<const FilterSelector*, FilterProgram> m_programs{};
+  bool m_root_queries{false};
+};
+
+// Call _func_ with _segments_ and every query nested in their filter
+// selectors, outermost first.
+void for_each_query(const segments_t& segments,
+                    const std::function<void(const segments_t&)>& func);
+
+// Python's `==` for JSON-like data. Exact built-in types are compared
+// natively, recursing into lists and dicts.
+bool equal_objects(const nb::object& left, const nb::object& right);
+
+// Compare two Python objects with JSONPath comparison semantics.
+bool compare_objects(const nb::object& left, BinaryOperator op,
+                     const nb::object& right);
+
+// JSONPath truthiness of a Python object. Everything but false is truthy.
+bool is_truthy(const nb::object& value);
+
+}  // namespace libjsonpath
+
+#endif
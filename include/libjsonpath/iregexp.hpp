@@ -0,0 +1,96 @@
+#ifndef LIBJSONPATH_IREGEXP_H
+#define LIBJSONPATH_IREGEXP_H
+
+#include <cstddef>      // size_t
+#include <cstdint>      // std::uint8_t
+#include <memory>       // std::shared_ptr
+#include <optional>     // std::optional
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+
+#include "nanobind/nanobind.h"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+// A regular expression in I-Regexp format (RFC 9485), compiled to a
+// nondeterministic finite automaton. Matching simulates the automaton one
+// character at a time without backtracking, so it takes time proportional to
+// the length of the subject string times the size of the pattern.
+//
+// As specified by I-Regexp, `^` and `$` are ordinary characters, and `.`
+// matches any character except `\n` and `\r`.
+class IRegexp {
+public:
+  // Compile _pattern_, or return null if _pattern_ is not a valid I-Regexp
+  // or would compile to an unreasonably large automaton.
+  static std::shared_ptr<const IRegexp> compile(std::string_view pattern);
+
+  // Like compile, but reuse recently compiled patterns.
+  static std::shared_ptr<const IRegexp> cached(std::string_view pattern);
+
+  // Like cached, but for a Python object. Return null if _pattern_ is not a
+  // str, or contains lone surrogates, which I-Regexp does not allow.
+  static std::shared_ptr<const IRegexp> cached(nb::handle pattern);
+
+  // Return true if all of the Python str _string_ matches this pattern.
+  bool match(nb::handle string) const { return test(string, true); }
+
+  // Return true if any substring of the Python str _string_ matches this
+  // pattern.
+  bool search(nb::handle string) const { return test(string, false); }
+
+  // A set of characters, like `[a-z\p{Lu}]`, `.` or `\P{N}`. Unicode
+  // categories are given by name, paired with true if they are negated.
+  struct CharSet {
+    std::vector<std::pair<char32_t, char32_t>> ranges{};
+    std::vector<std::pair<std::string, bool>> categories{};
+    bool negated{false};
+
+    bool contains(char32_t c) const;
+  };
+
+  enum class Opcode : std::uint8_t {
+    // Consume the character _c_.
+    character,
+    // Consume any character in sets[x].
+    set,
+    // Continue at both _x_ and _y_.
+    split,
+    jump,
+    match,
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    char32_t c;
+    size_t x;
+    size_t y;
+  };
+
+  IRegexp(std::vector<Instruction> program, std::vector<CharSet> sets,
+          std::optional<std::string> literal)
+      : m_program{std::move(program)},
+        m_sets{std::move(sets)},
+        m_literal{std::move(literal)} {}
+
+private:
+  std::vector<Instruction> m_program;
+  std::vector<CharSet> m_sets;
+
+  // The UTF-8 encoded string matched by this pattern, if it matches exactly
+  // one string.
+  std::optional<std::string> m_literal;
+
+  bool test(nb::handle string, bool anchored) const;
+
+  template <typename Source>
+  bool run(Source source, bool anchored) const;
+};
+
+}  // namespace libjsonpath
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef LIBJSONPATH_KERNELS_H
+#define LIBJSONPATH_KERNELS_H
+
+#include <cstddef>      // size_t
+#include <cstdint>      // std::int64_t std::uint8_t std::uint64_t
+#include <optional>     // std::optional
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+
+#include "libjsonpath/selectors.hpp"
+
+namespace libjsonpath {
+
+// Bit _i_ % 64 of word _i_ / 64 is set if item _i_ is selected.
+using bitmap_t = std::vector<std::uint64_t>;
+
+// The literal in a filter like `@ > 42.5` or `@ == 'abc'`. Strings are UTF-8
+// encoded, so comparing their bytes orders them by code point, like Python.
+struct ComparisonLiteral {
+  enum class Kind : std::uint8_t { integer, real, string };
+
+  Kind kind;
+  std::int64_t integer;
+  double real;
+  std::string string;
+};
+
+// The items of an array of numbers, or of short strings, unboxed so they can
+// be compared with a literal all at once, with SSE2 or AVX2 where the CPU
+// has them and with plain loops otherwise.
+//
+// Comparisons follow the same rules as comparing Python objects. Integers
+// are compared exactly, and integers are only compared with floats when
+// every integer involved is exactly representable as a double.
+class ComparisonColumn {
+public:
+  // Strings longer than this many bytes aren't short.
+  static constexpr size_t short_string_size = 16;
+
+  // Add the next item. Return false if the item doesn't belong in the
+  // column, like a string in a column of numbers or a long string, in which
+  // case the column can't be used.
+  bool push_integer(std::int64_t value);
+  bool push_real(double value);
+  bool push_string(std::string_view value);
+
+  size_t size() const { return m_size; }
+
+  // Compare every item with _literal_ using _op_. Return nothing if the
+  // comparison can't be made exactly with C types, like comparing a float
+  // with an integer that isn't exactly representable as a double, or if the
+  // literal and items are of different kinds.
+  std::optional<bitmap_t> compare(BinaryOperator op,
+                                  const ComparisonLiteral& literal) const;
+
+private:
+  enum class Kind : std::uint8_t { empty, integer, real, string };
+
+  Kind m_kind{Kind::empty};
+  size_t m_size{0};
+  // True if every integer pushed so far is exactly representable as a
+  // double.
+  bool m_exact{true};
+
+  std::vector<std::int64_t> m_integers{};
+  std::vector<double> m_reals{};
+  // short_string_size bytes for each string, padded with zeros.
+  std::vector<char> m_strings{};
+  std::vector<std::uint8_t> m_lengths{};
+};
+
+// Call _func_ with the index of each item selected in _bitmap_, in order.
+template <typename Func>
+void for_each_selected(const bitmap_t& bitmap, Func&& func) {
+  for (size_t word = 0; word < bitmap.size(); word++) {
+    std::uint64_t bits{bitmap[word]};
+    while (bits) {
+#if defined(__GNUC__) || defined(__clang__)
+      size_t bit{static_cast<size_t>(__builtin_ctzll(bits))};
+#else
+      size_t bit{0};
+      while (!((bits >> bit) & 1)) {
+        bit++;
+      }
+#endif
+      func(word * 64 + bit);
+      bits &= bits - 1;
+    }
+  }
+}
+
+}  // namespace libjsonpath
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef LIBJSONPATH_NDJSON_H
+#define LIBJSONPATH_NDJSON_H
+
+#include <algorithm>           // std::count std::min
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // size_t
+#include <exception>           // std::exception_ptr std::current_exception
+#include <functional>          // std::function
+#include <map>                 // std::map
+#include <mutex>               // std::mutex std::unique_lock
+#include <optional>            // std::optional
+#include <string>              // std::string
+#include <string_view>         // std::string_view
+#include <thread>              // std::thread
+#include <utility>             // std::move std::pair
+#include <vector>              // std::vector
+
+namespace libjsonpath {
+
+// A whole file mapped into memory, read only. Raises OSError if the file
+// can't be opened or mapped.
+class MappedFile {
+public:
+  explicit MappedFile(const std::string& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  std::string_view text() const { return {m_data, m_size}; }
+
+private:
+  const char* m_data{nullptr};
+  size_t m_size{0};
+#ifdef _WIN32
+  void* m_file{nullptr};
+  void* m_mapping{nullptr};
+#endif
+};
+
+// Runs _work_ for every line of some text on a pool of threads. Each thread
+// claims the next chunk of whole lines, calls _work_ for every line that
+// isn't blank, and hands back the chunk's results, which the consumer takes
+// in document order, or in the order chunks are finished if _ordered_ is
+// false.
+//
+// At most _capacity_ chunks are claimed but not yet taken, so memory use is
+// bounded however long the text is. Threads don't touch the Python
+// interpreter, so neither can _work_, and callers should release the GIL
+// while waiting in next.
+template <typename Result>
+class LineWorkers {
+public:
+  // _work_ is called with a line's number, counting from one, and its text
+  // without the line ending. It returns nothing to skip a line.
+  using work_t =
+      std::function<std::optional<Result>(size_t, std::string_view)>;
+
+  // Results of one chunk, with their line numbers. If _work_ throws, the
+  // chunk ends with the exception and no more chunks are claimed.
+  struct Chunk {
+    std::vector<std::pair<size_t, Result>> results{};
+    std::exception_ptr error{};
+  };
+
+  static constexpr size_t default_chunk_size = 1 << 20;
+
+  LineWorkers(std::string_view text, work_t work, size_t threads,
+              bool ordered, size_t chunk_size = default_chunk_size)
+      : m_text{text},
+        m_work{std::move(work)},
+        m_ordered{ordered},
+        m_chunk_size{chunk_size ? chunk_size : default_chunk_size} {
+    if (!threads) {
+      threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    m_capacity = threads * 2;
+    m_threads.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+      m_threads.emplace_back([this]() { run(); });
+    }
+  }
+
+  LineWorkers(const LineWorkers&) = delete;
+  LineWorkers& operator=(const LineWorkers&) = delete;
+
+  ~LineWorkers() {
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_stopped = true;
+    }
+    m_space.notify_all();
+    for (auto& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  // Wait for the next chunk, or return nothing if every chunk has been
+  // taken.
+  std::optional<Chunk> next() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_ready.wait(lock, [this]() { return ready() || finished(); });
+    if (!ready()) {
+      return std::nullopt;
+    }
+
+    auto it{m_ordered ? m_done.find(m_taken) : m_done.begin()};
+    Chunk chunk{std::move(it->second)};
+    m_done.erase(it);
+    m_taken++;
+    lock.unlock();
+    m_space.notify_all();
+    return chunk;
+  }
+
+private:
+  std::string_view m_text;
+  work_t m_work;
+  bool m_ordered;
+  size_t m_chunk_size;
+  size_t m_capacity{0};
+
+  std::mutex m_mutex{};
+  // Signalled when a chunk is finished.
+  std::condition_variable m_ready{};
+  // Signalled when a chunk is taken, or when we're stopping.
+  std::condition_variable m_space{};
+
+  // The offset and line number of the first unclaimed line.
+  size_t m_position{0};
+  size_t m_line{1};
+  // Chunks are numbered in the order they are claimed.
+  size_t m_claimed{0};
+  size_t m_taken{0};
+  std::map<size_t, Chunk> m_done{};
+  bool m_stopped{false};
+
+  std::vector<std::thread> m_threads{};
+
+  bool ready() const {
+    return m_ordered ? m_done.count(m_taken) > 0 : !m_done.empty();
+  }
+
+  bool finished() const {
+    return m_position == m_text.size() && m_taken == m_claimed;
+  }
+
+  void run() {
+    while (true) {
+      size_t index{0};
+      size_t line{0};
+      std::string_view text{};
+      {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_space.wait(lock, [this]() {
+          return m_stopped || m_position == m_text.size() ||
+                 m_claimed - m_taken < m_capacity;
+        });
+        if (m_stopped || m_position == m_text.size()) {
+          return;
+        }
+
+        // Chunks end after the first line ending at or after the chunk size.
+        size_t end{m_text.size()};
+        if (m_text.size() - m_position > m_chunk_size) {
+          end = m_text.find('\n', m_position + m_chunk_size - 1);
+          end = end == std::string_view::npos ? m_text.size() : end + 1;
+        }
+
+        text = m_text.substr(m_position, end - m_position);
+        index = m_claimed++;
+        line = m_line;
+        m_line += static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+        m_position = end;
+      }
+
+      Chunk chunk{};
+      try {
+        for (size_t start = 0; start < text.size(); line++) {
+          size_t stop{std::min(text.find('\n', start), text.size())};
+          auto line_text{text.substr(start, stop - start)};
+          start = stop + 1;
+          if (!line_text.empty() && line_text.back() == '\r') {
+            line_text.remove_suffix(1);
+          }
+          if (line_text.find_first_not_of(" \t\r") == std::string_view::npos) {
+            continue;
+          }
+          if (auto result{m_work(line, line_text)}) {
+            chunk.results.emplace_back(line, std::move(*result));
+          }
+        }
+      } catch (...) {
+        chunk.error = std::current_exception();
+      }
+
+      {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        if (chunk.error) {
+          m_position = m_text.size();
+        }
+        m_done.emplace(index, std::move(chunk));
+      }
+      m_ready.notify_all();
+    }
+  }
+};
+
+}  // namespace libjsonpath
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef LIBJSONPATH_NODE_H
 #define LIBJSONPATH_NODE_H
 
+#include <cstddef>  // size_t
+#include <memory>   // std::shared_ptr
 #include <string>
 #include <variant>
 #include <vector>
@@ -13,20 +15,43 @@ namespace libjsonpath {
 
 using location_t = std::vector<std::variant<size_t, std::string>>;
 
+// One step in a node's location, linked to the step before it. Child nodes
+// share their parent's chain instead of copying it, and name keys are kept
+// as Python str objects until someone asks for the location.
+struct LocationStep {
+  std::shared_ptr<LocationStep> parent;
+  std::variant<size_t, nb::str> key;
+  size_t depth;
+
+  ~LocationStep();
+};
+
+// An empty chain is the location of the root node.
+using location_chain_t = std::shared_ptr<LocationStep>;
+
 // A JSON-like object and its location within a JSON document.
 class JSONPathNode {
 public:
   nb::object value;
-  location_t location;
 
-  JSONPathNode(nb::object &value_, location_t location_);
+  JSONPathNode(nb::object &value_, location_chain_t chain_ = nullptr);
+
+  // Return a new node for _value_, at _index_ or _name_ from this node.
+  JSONPathNode child(nb::object &value_, size_t index) const;
+  JSONPathNode child(nb::object &value_, nb::str name) const;
+
+  // Build the list of keys and indices leading to this node.
+  location_t location() const;
 
   // Return the canonical string representation of the path to this node.
-  std::string path();
+  std::string path() const;
+
+private:
+  location_chain_t m_chain;
 };
 
 using JSONPathNodeList = std::vector<JSONPathNode>;
 
 }  // namespace libjsonpath
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,65 @@
+#ifndef LIBJSONPATH_PARALLEL_H
+#define LIBJSONPATH_PARALLEL_H
+
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // size_t
+#include <deque>               // std::deque
+#include <functional>          // std::function
+#include <mutex>               // std::mutex
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+
+namespace libjsonpath {
+
+// Worker threads that are started the first time they are needed and kept
+// until the pool is destroyed, so queries that are split into tasks don't
+// pay for starting threads every time.
+//
+// A pool can be used by several threads at once. Their tasks share the
+// workers, and each calling thread works on its own tasks too, so calls
+// always finish, even if every worker is busy with another call.
+class ThreadPool {
+public:
+  // A pool of _threads_ threads, including the calling thread, or one per
+  // core if _threads_ is zero.
+  explicit ThreadPool(size_t threads = 0);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // The number of threads, including the calling thread.
+  size_t size() const { return m_size; }
+
+  // Call _task_ with every index from zero up to _tasks_. Each thread starts
+  // with an equal, contiguous share of the tasks. A thread that runs out
+  // steals the second half of the largest share left, so uneven tasks still
+  // keep every thread busy.
+  //
+  // If a task throws, no more tasks are started, and the first exception is
+  // rethrown once every thread has finished. Tasks must not touch the Python
+  // interpreter, as the caller is expected to release the GIL.
+  void parallel_for(size_t tasks, const std::function<void(size_t)>& task);
+
+private:
+  struct Batch;
+
+  // Run share _share_ of _batch_.
+  struct Job {
+    Batch* batch;
+    size_t share;
+  };
+
+  size_t m_size;
+  std::mutex m_mutex{};
+  std::condition_variable m_work{};
+  std::condition_variable m_done{};
+  std::deque<Job> m_jobs{};
+  std::vector<std::thread> m_workers{};
+  bool m_stop{false};
+
+  void run();
+};
+
+}  // namespace libjsonpath
+
+#endif
@@ -1,9 +1,23 @@
 #ifndef LIBJSONPATH_PATH_H
 #define LIBJSONPATH_PATH_H
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
+#include "libjsonpath/cache.hpp"
+#include "libjsonpath/document.hpp"
+#include "libjsonpath/filter.hpp"
 #include "libjsonpath/node.hpp"
+#include "libjsonpath/parallel.hpp"
 #include "libjsonpath/parse.hpp"
 #include "nanobind/nanobind.h"
 
@@ -11,37 +25,468 @@ namespace nb = nanobind;
 
 namespace libjsonpath {
 
-using function_extension_map = std::unordered_map<std::string, nb::callable>;
-
 // Apply the JSONPath query represented by _segments_ to JSON-like data _obj_.
 JSONPathNodeList query_(const segments_t& segments, nb::object obj,
-                        function_extension_map functions,
-                        function_signature_map signatures, nb::object nothing);
+                        const function_extension_map& functions,
+                        const function_signature_map& signatures,
+                        nb::object nothing);
 
 // Parse the JSONPath query expression _path_ and use it to query JSON-like
 // data in _obj_.
 JSONPathNodeList query_(std::string_view path, nb::object obj,
-                        function_extension_map functions,
-                        function_signature_map signatures, nb::object nothing);
+                        const function_extension_map& functions,
+                        const function_signature_map& signatures,
+                        nb::object nothing);
+
+// Python strings for every name selector in some segments, including those
+// in filter queries. Names are interned when the query is compiled, so dict
+// lookups reuse their cached hashes instead of building a new string for
+// every node.
+class SelectorNames {
+public:
+  explicit SelectorNames(const segments_t& segments);
+  SelectorNames(const SelectorNames&) = delete;
+  SelectorNames& operator=(const SelectorNames&) = delete;
+
+  const nb::str& get(const NameSelector& selector) const {
+    return m_names.at(&selector);
+  }
+
+private:
+  std::unordered_map<const NameSelector*, nb::str> m_names{};
+};
+
+// Filter programs that can be evaluated directly against a JSONDocument's
+// elements, without converting candidates to Python objects and without
+// holding the GIL. Programs that call function extensions are left to
+// FilterMachine, as are the few comparisons only Python can decide, like
+// those between integers that don't fit in 64 bits.
+class DocumentFilters {
+public:
+  // A literal from a compiled filter program.
+  struct Literal {
+    JSONDocument::Type type;
+    std::int64_t integer;
+    double real;
+    std::string string;
+    // True if the literal is equal to the environment's nothing object.
+    bool nothing;
+  };
+
+  struct Program {
+    const FilterProgram& program;
+    std::vector<Literal> literals;
+  };
+
+  DocumentFilters(const segments_t& segments, const FilterPrograms& filters,
+                  nb::handle nothing);
+  DocumentFilters(const DocumentFilters&) = delete;
+  DocumentFilters& operator=(const DocumentFilters&) = delete;
+
+  // Return the program for _selector_, or null if it, or a filter nested in
+  // one of its queries, can't be evaluated natively.
+  const Program* get(const FilterSelector& selector) const {
+    auto it{m_programs.find(&selector)};
+    return it == m_programs.end() ? nullptr : &it->second;
+  }
+
+  // True if every filter selector in _segment_ can be evaluated natively.
+  bool native(const segments_t::value_type& segment) const;
+
+private:
+  std::unordered_map<const FilterSelector*, Program> m_programs{};
+};
+
+// A parsed JSONPath query and its compiled filters, with function calls
+// bound to _functions_. Tokens in _segments_ refer to _path_, so a QueryPlan
+// owns its own copy of the query string and is never copied.
+class QueryPlan {
+public:
+  QueryPlan(std::string_view path_, const Parser& parser,
+            const function_extension_map& functions,
+            const function_signature_map& signatures, nb::handle nothing);
+
+  // A plan for _segments_, which have already been parsed. _path_ is their
+  // canonical string form.
+  QueryPlan(segments_t segments_, const function_extension_map& functions,
+            const function_signature_map& signatures, nb::handle nothing);
+  QueryPlan(const QueryPlan&) = delete;
+  QueryPlan& operator=(const QueryPlan&) = delete;
+
+  const std::string path;
+  const segments_t segments;
+  const FilterPrograms filters;
+  const SelectorNames names;
+  const DocumentFilters document_filters;
+
+  // True if the query is made of child segments with a single name or index
+  // selector, so it selects at most one node.
+  const bool singular;
+};
+
+using query_cache_t = LRUCache<std::shared_ptr<const QueryPlan>>;
+
+class CompiledQuery;
+class CompiledQuerySet;
+
+// The data and compiled query shared by every filter evaluated during one
+// query of Python objects. Queries of a JSONDocument make one too, for
+// filters that can only be evaluated in Python.
+class QueryContext {
+public:
+  QueryContext(nb::object root_, nb::object nothing_,
+               const FilterPrograms& filters_, const SelectorNames& names_);
+
+  const nb::object root;
+  const nb::object nothing;
+  const FilterPrograms& filters;
+  const SelectorNames& names;
+
+  // Results of root queries in filters, evaluated so far.
+  mutable std::unordered_map<const FilterQuery*, JSONPathNodeList>
+      root_queries{};
+};
+
+// Return true if the filter _selector_ selects the Python object _current_.
+bool test_filter(const QueryContext& q_ctx, const FilterSelector& selector,
+                 nb::handle current);
+
+// Convert negative indicies to their positive equivalents given
+// an "array" length.
+size_t normalized_index(size_t length, std::int64_t index, const Token& token);
+
+// Normalized start, stop and step for a slice selector applied to an array.
+struct SliceBounds {
+  std::int64_t start;
+  std::int64_t stop;
+  std::int64_t step;
+
+  bool in_range(std::int64_t i) const {
+    return step > 0 ? i < stop : i > stop;
+  }
+};
+
+// Compute slice bounds for an array of length _size_. Iterate with
+// `for (auto i{bounds.start}; bounds.in_range(i); i += bounds.step)`.
+SliceBounds slice_bounds(const SliceSelector& selector, size_t size);
+
+using selector_list_t = decltype(Segment::selectors);
+
+// Return the selectors of a child or recursive segment.
+const selector_list_t& segment_selectors(
+    const std::variant<Segment, RecursiveSegment>& segment);
+
+// Arrays shorter than this are filtered one item at a time, even if the
+// filter is a LiteralComparison.
+constexpr size_t min_column_size = 32;
+
+
+// Marks an iterator as running for the lifetime of a call to its next. Like
+// a generator, an iterator that is already running, in another thread or
+// further up the stack, raises a ValueError instead of interleaving two
+// evaluations of its state.
+class Running {
+public:
+  explicit Running(std::atomic<bool>& running) : m_running{running} {
+    if (m_running.exchange(true)) {
+      throw nb::value_error("iterator already executing");
+    }
+  }
+  Running(const Running&) = delete;
+  Running& operator=(const Running&) = delete;
+  ~Running() { m_running = false; }
+
+private:
+  std::atomic<bool>& m_running;
+};
+
+// A pull-based, depth-first evaluation of a JSONPath query. Nodes are
+// produced in the same order as Env_::query, but intermediate node lists are
+// never built, so memory use is proportional to the depth of the query
+// rather than the size of its result.
+class NodeIterator {
+public:
+  struct State;
+
+  explicit NodeIterator(std::unique_ptr<State> state);
+  NodeIterator(NodeIterator&&) noexcept;
+  ~NodeIterator();
+
+  // Return the next node, or nothing if the query is exhausted.
+  std::optional<JSONPathNode> next();
+
+private:
+  std::unique_ptr<State> m_state;
+};
+
+// Query results for one line of a newline-delimited JSON file. _nodes_ is
+// empty if the query was started with findall_ndjson, and _values_ is empty
+// otherwise.
+struct NDJSONLine {
+  size_t line;
+  JSONPathNodeList nodes;
+  nb::list values;
+};
+
+// Applies a query to every line of a newline-delimited JSON file. The file
+// is memory mapped and lines are parsed, and queries without filters are
+// evaluated, on a pool of threads without holding the GIL. Only selected
+// values are converted to Python objects. Lines with no matches are skipped.
+//
+// Lines are produced in file order, unless _ordered_ is false, in which case
+// they are produced as soon as they are ready.
+class NDJSONIterator {
+public:
+  struct State;
+
+  explicit NDJSONIterator(std::unique_ptr<State> state);
+  NDJSONIterator(NDJSONIterator&&) noexcept;
+  ~NDJSONIterator();
+
+  // Return results for the next line with at least one match, or nothing if
+  // there are no more lines. Raises JSONDecodeError for lines that aren't
+  // valid JSON.
+  std::optional<NDJSONLine> next();
+
+  // True if this iterator produces values rather than nodes.
+  bool values() const;
+
+private:
+  std::unique_ptr<State> m_state;
+};
 
 class Env_ {
 private:
-  function_extension_map m_functions{};
-  function_signature_map m_signatures{};
+  // Function extensions, and everything that depends on them. A snapshot is
+  // never changed once it's published, apart from its cache, which has its
+  // own lock. Registering a function publishes a new snapshot, so a query
+  // started before then finishes with the functions it started with, and
+  // plans compiled with old functions never reach the new snapshot's cache.
+  struct Snapshot {
+    Snapshot(function_extension_map functions_,
+             function_signature_map signatures_, size_t cache_size)
+        : functions{std::move(functions_)},
+          signatures{std::move(signatures_)},
+          parser{signatures},
+          cache{cache_size} {}
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    const function_extension_map functions;
+    const function_signature_map signatures;
+    const Parser parser;
+    mutable query_cache_t cache;
+  };
+
   nb::object m_nothing{};
-  Parser m_parser{};
+  size_t m_cache_size;
+  size_t m_parallel_threshold;
+
+  // Threads for parallel evaluation, which are started by the first query
+  // that needs them.
+  ThreadPool m_pool;
+
+  // Always read and replaced with std::atomic_load and std::atomic_store, so
+  // threads can query while another thread registers a function.
+  std::shared_ptr<const Snapshot> m_snapshot;
+
+  // Serializes register_function.
+  std::mutex m_register_mutex{};
+
+  std::shared_ptr<const Snapshot> snapshot() const {
+    return std::atomic_load(&m_snapshot);
+  }
 
 public:
+  static constexpr size_t default_cache_size = 256;
+
+  // Queries of JSONDocuments apply wildcard, slice and filter selectors to
+  // arrays with at least _parallel_threshold_ items on _threads_ threads, or
+  // one per core if _threads_ is zero. A threshold of zero means never.
   Env_(function_extension_map functions, function_signature_map signatures,
-       nb::object nothing)
-      : m_functions{functions},
-        m_signatures{signatures},
-        m_nothing{nothing},
-        m_parser{signatures} {}
+       nb::object nothing, size_t cache_size = default_cache_size,
+       size_t parallel_threshold = 0, size_t threads = 0)
+      : m_nothing{nothing},
+        m_cache_size{cache_size},
+        m_parallel_threshold{parallel_threshold},
+        m_pool{threads},
+        m_snapshot{std::make_shared<const Snapshot>(
+            std::move(functions), std::move(signatures), cache_size)} {}
+
+  // Add or replace the function extension _name_. This clears the query
+  // cache, as cached queries were validated against the old signatures.
+  void register_function(const std::string& name, nb::callable func,
+                         const FunctionExtensionTypes& signature);
 
   JSONPathNodeList query(std::string_view path, nb::object obj);
+  JSONPathNodeList query(const QueryPlan& plan, nb::object obj);
   JSONPathNodeList from_segments(const segments_t& segments, nb::object obj);
+
+  // Like query, but return a list of values without building nodes or
+  // locations.
+  nb::list findall(std::string_view path, nb::object obj);
+  nb::list findall(const QueryPlan& plan, nb::object obj);
+
+  // Query a parsed JSON document. Only selected values are converted to
+  // Python objects.
+  JSONPathNodeList query(std::string_view path, const JSONDocument& doc);
+  JSONPathNodeList query(const QueryPlan& plan, const JSONDocument& doc);
+  nb::list findall(std::string_view path, const JSONDocument& doc);
+  nb::list findall(const QueryPlan& plan, const JSONDocument& doc);
+
+  // Like findall, but write the values to a TypedArray of type _dtype_ and
+  // return it as an array.array. Numbers in a JSONDocument are read without
+  // converting them to Python objects.
+  nb::object findall_array(std::string_view path, nb::object obj,
+                           std::string_view dtype, bool masked = false);
+  nb::object findall_array(const QueryPlan& plan, nb::object obj,
+                           std::string_view dtype, bool masked = false);
+  nb::object findall_array(std::string_view path, const JSONDocument& doc,
+                           std::string_view dtype, bool masked = false);
+  nb::object findall_array(const QueryPlan& plan, const JSONDocument& doc,
+                           std::string_view dtype, bool masked = false);
+
+  // Like findall, but return the values as a UTF-8 encoded JSON array,
+  // written by a JSONWriter. Values in a JSONDocument are written without
+  // converting them to Python objects.
+  nb::bytes findall_json(std::string_view path, nb::object obj);
+  nb::bytes findall_json(const QueryPlan& plan, nb::object obj);
+  nb::bytes findall_json(std::string_view path, const JSONDocument& doc);
+  nb::bytes findall_json(const QueryPlan& plan, const JSONDocument& doc);
+
+  // Like findall_json, but write a {"path": ..., "value": ...} object for
+  // each node, where path is the node's normalized path.
+  nb::bytes query_json(std::string_view path, nb::object obj);
+  nb::bytes query_json(const QueryPlan& plan, nb::object obj);
+  nb::bytes query_json(std::string_view path, const JSONDocument& doc);
+  nb::bytes query_json(const QueryPlan& plan, const JSONDocument& doc);
+
+  // Return the value of the first node matching _path_, or the environment's
+  // nothing object if there are no matches. Singular queries look up each
+  // name and index directly.
+  nb::object get(std::string_view path, nb::object obj);
+  nb::object get(const QueryPlan& plan, nb::object obj);
+
+  // Like get, but return the first node, with its location.
+  std::optional<JSONPathNode> query_one(std::string_view path, nb::object obj);
+  std::optional<JSONPathNode> query_one(const QueryPlan& plan, nb::object obj);
+
   segments_t parse(std::string_view path);
+
+  // Parse _path_, or get it from the cache of recently parsed queries.
+  std::shared_ptr<const QueryPlan> plan(std::string_view path);
+
+  // Parse _path_ into a reusable query bound to this environment.
+  CompiledQuery compile(std::string_view path);
+
+  // Like compile, for a query that has already been parsed. These plans
+  // aren't cached.
+  CompiledQuery compile(const segments_t& segments);
+
+  // Parse _paths_ into a set of queries that are applied together.
+  CompiledQuerySet query_set(const std::vector<std::string>& paths);
+
+  // Lazily apply a query to _obj_, one node at a time.
+  NodeIterator finditer(std::string_view path, nb::object obj);
+  NodeIterator finditer(std::shared_ptr<const QueryPlan> plan,
+                        nb::object obj);
+
+  // Apply a query to each line of the newline-delimited JSON file at _path_,
+  // using _threads_ worker threads, or one per core if _threads_ is zero.
+  NDJSONIterator query_ndjson(std::string_view query, const std::string& path,
+                              size_t threads = 0, bool ordered = true);
+  NDJSONIterator findall_ndjson(std::string_view query,
+                                const std::string& path, size_t threads = 0,
+                                bool ordered = true);
+  NDJSONIterator ndjson(std::shared_ptr<const QueryPlan> plan,
+                        const std::string& path, size_t threads, bool ordered,
+                        bool values);
+
+  CacheInfo cache_info() const;
+  void cache_clear();
+};
+
+// A parsed JSONPath query and the environment it was compiled with. Segments
+// stay in C++, so querying with a CompiledQuery does not convert the query's
+// syntax tree to or from Python objects.
+class CompiledQuery {
+private:
+  Env_* m_env;
+  std::shared_ptr<const QueryPlan> m_plan;
+
+public:
+  CompiledQuery(Env_* env, std::shared_ptr<const QueryPlan> plan)
+      : m_env{env}, m_plan{std::move(plan)} {}
+
+  JSONPathNodeList query(nb::object obj) const;
+  NodeIterator finditer(nb::object obj) const;
+  nb::list findall(nb::object obj) const;
+  JSONPathNodeList query(const JSONDocument& doc) const;
+  nb::list findall(const JSONDocument& doc) const;
+  nb::object findall_array(nb::object obj, std::string_view dtype,
+                           bool masked = false) const;
+  nb::object findall_array(const JSONDocument& doc, std::string_view dtype,
+                           bool masked = false) const;
+  nb::bytes findall_json(nb::object obj) const;
+  nb::bytes findall_json(const JSONDocument& doc) const;
+  nb::bytes query_json(nb::object obj) const;
+  nb::bytes query_json(const JSONDocument& doc) const;
+  nb::object get(nb::object obj) const;
+  std::optional<JSONPathNode> query_one(nb::object obj) const;
+  NDJSONIterator query_ndjson(const std::string& path, size_t threads = 0,
+                              bool ordered = true) const;
+  NDJSONIterator findall_ndjson(const std::string& path, size_t threads = 0,
+                                bool ordered = true) const;
+
+  const std::string& path() const { return m_plan->path; }
+  const segments_t& segments() const { return m_plan->segments; }
+};
+
+// Several queries applied to the same data together. Queries are merged into
+// a trie of segments, so segments shared by the start of more than one query
+// are evaluated once per document. Segments with filter selectors are never
+// shared.
+class CompiledQuerySet {
+private:
+  using segment_t = segments_t::value_type;
+
+  // A segment of one or more queries, and the segments that follow it.
+  struct Branch {
+    const segment_t* segment;
+    // Index of the plan that _segment_ belongs to.
+    size_t plan;
+    std::vector<size_t> children;
+    // Indices of queries that end with this segment.
+    std::vector<size_t> queries;
+  };
+
+  std::vector<std::shared_ptr<const QueryPlan>> m_plans;
+  nb::object m_nothing;
+  // The root of the trie is m_branches[0], which has no segment.
+  std::vector<Branch> m_branches;
+
+  template <typename Nodes>
+  std::vector<std::vector<typename Nodes::node_t>> run(nb::object obj) const;
+
+  template <typename Nodes>
+  void visit(const std::vector<QueryContext>& contexts, size_t index,
+             const std::vector<typename Nodes::node_t>& nodes,
+             std::vector<std::vector<typename Nodes::node_t>>& results) const;
+
+public:
+  CompiledQuerySet(std::vector<std::shared_ptr<const QueryPlan>> plans,
+                   nb::object nothing);
+
+  // Apply every query to _obj_, returning one node list per query in the
+  // order the queries were given. Each node list is the same as the one
+  // Env_::query would return.
+  std::vector<JSONPathNodeList> query(nb::object obj) const;
+
+  // Like query, but return a list of values for each query.
+  nb::list findall(nb::object obj) const;
+
+  std::vector<std::string> paths() const;
+  size_t size() const { return m_plans.size(); }
 };
 
 }  // namespace libjsonpath
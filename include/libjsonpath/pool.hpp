@@ -0,0 +1,72 @@
+#ifndef LIBJSONPATH_POOL_H
+#define LIBJSONPATH_POOL_H
+
+#include <cstddef>  // size_t
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+namespace libjsonpath {
+
+// A vector whose storage comes from, and goes back to, a thread-local pool of
+// spare vectors. Intermediate node lists and filter stacks are built for
+// every query, segment and filter, so reusing their storage keeps the heap
+// allocator out of the hot path.
+//
+// Vectors are cleared before they go back into the pool, so pooled storage
+// never holds references to Python objects. Vectors that grew very large are
+// freed rather than pooled.
+template <typename T>
+class PooledVector {
+private:
+  static constexpr size_t max_pooled = 32;
+  static constexpr size_t max_capacity = 1 << 16;
+
+  std::vector<T> m_items;
+
+  static std::vector<std::vector<T>>& pool() {
+    thread_local std::vector<std::vector<T>> pool_{};
+    return pool_;
+  }
+
+public:
+  PooledVector() : m_items{acquire()} {}
+  PooledVector(PooledVector&& other) noexcept
+      : m_items{std::move(other.m_items)} {
+    other.m_items = std::vector<T>{};
+  }
+  PooledVector(const PooledVector&) = delete;
+  PooledVector& operator=(const PooledVector&) = delete;
+  PooledVector& operator=(PooledVector&&) = delete;
+
+  ~PooledVector() { release(std::move(m_items)); }
+
+  std::vector<T>& operator*() { return m_items; }
+  const std::vector<T>& operator*() const { return m_items; }
+  std::vector<T>* operator->() { return &m_items; }
+  const std::vector<T>* operator->() const { return &m_items; }
+
+  // Take a cleared vector from the pool, or a new one if the pool is empty.
+  static std::vector<T> acquire() {
+    auto& pool_{pool()};
+    if (pool_.empty()) {
+      return {};
+    }
+    std::vector<T> items{std::move(pool_.back())};
+    pool_.pop_back();
+    return items;
+  }
+
+  // Clear _items_ and keep its storage for later, unless it has none.
+  static void release(std::vector<T>&& items) {
+    items.clear();
+    auto& pool_{pool()};
+    if (items.capacity() && items.capacity() <= max_capacity &&
+        pool_.size() < max_pooled) {
+      pool_.push_back(std::move(items));
+    }
+  }
+};
+
+}  // namespace libjsonpath
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef LIBJSONPATH_SERIALIZE_H
+#define LIBJSONPATH_SERIALIZE_H
+
+#include <cstdint>        // std::int64_t
+#include <string>         // std::string
+#include <string_view>    // std::string_view
+#include <unordered_set>  // std::unordered_set
+
+#include "nanobind/nanobind.h"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+// Builds compact, UTF-8 encoded JSON text, like json.dumps with
+// ensure_ascii=False and separators=(",", ":"), without going through
+// Python for the types JSON is made of.
+//
+// Like json.dumps, NaN and infinities are written as NaN, Infinity and
+// -Infinity, floats are written like their repr, and containers that
+// contain themselves raise ValueError. Lone surrogates, which can't be
+// encoded as UTF-8, are written as \u escapes.
+class JSONWriter {
+public:
+  // Exact dicts, lists, strs, ints, floats, bools and None are written
+  // directly. Anything else is passed to json.JSONEncoder, so it is written
+  // like json.dumps would, or raises the same TypeError.
+  void write(nb::handle value);
+
+  // Write _value_, which is UTF-8 encoded, as a JSON string. Surrogates
+  // encoded like Python's "surrogatepass" error handler does are escaped.
+  void write_string(std::string_view value);
+
+  void write_integer(std::int64_t value);
+  void write_real(double value);
+
+  // Append _text_, which must already be JSON, like punctuation or a
+  // literal name.
+  void write_raw(std::string_view text) { m_out.append(text); }
+
+  nb::bytes to_bytes() const;
+
+private:
+  std::string m_out{};
+
+  // Created the first time it is needed.
+  nb::object m_encoder{};
+
+  // Dicts and lists being written, like json's check_circular markers.
+  std::unordered_set<PyObject*> m_markers{};
+
+  // Adds a container to m_markers for as long as it is being written, or
+  // raises ValueError if it is already there.
+  class Marker {
+  public:
+    Marker(JSONWriter& writer, PyObject* value);
+    Marker(const Marker&) = delete;
+    Marker& operator=(const Marker&) = delete;
+    ~Marker();
+
+  private:
+    JSONWriter& m_writer;
+    PyObject* m_value;
+  };
+
+  void write_str(PyObject* value);
+  void write_dict(PyObject* value);
+  void write_list(PyObject* value);
+  void write_key(PyObject* key);
+  void write_other(nb::handle value);
+};
+
+// Counts nested containers against Python's recursion limit, like
+// json.dumps does, so deeply nested data raises RecursionError rather than
+// overflowing the stack.
+class RecursionGuard {
+public:
+  RecursionGuard() {
+    if (Py_EnterRecursiveCall(" while encoding a JSON object")) {
+      throw nb::python_error();
+    }
+  }
+  RecursionGuard(const RecursionGuard&) = delete;
+  RecursionGuard& operator=(const RecursionGuard&) = delete;
+  ~RecursionGuard() { Py_LeaveRecursiveCall(); }
+};
+
+}  // namespace libjsonpath
+
+#endif
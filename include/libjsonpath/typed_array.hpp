@@ -0,0 +1,63 @@
+#ifndef LIBJSONPATH_TYPED_ARRAY_H
+#define LIBJSONPATH_TYPED_ARRAY_H
+
+#include <cstddef>      // size_t
+#include <cstdint>      // std::int64_t std::uint64_t
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+
+#include "nanobind/nanobind.h"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+// Values written to a contiguous buffer of one C type, which becomes an
+// array.array, so results can be handed to anything that reads the buffer
+// protocol without building a Python object per value.
+//
+// _dtype_ is one of the array module's numeric type codes, like "d" or "q",
+// or a NumPy style name, like "float64" or "int32". Exact ints fit integer
+// types if they are in range and fit floating point types if they can be
+// converted to a double. Exact floats only fit floating point types. Nothing
+// else fits, including bools.
+//
+// A value that doesn't fit raises a TypeError, or if _masked_ is true, is
+// stored as zero and marked in a mask of the same length.
+class TypedArray {
+public:
+  // Throws nb::value_error if _dtype_ isn't supported.
+  TypedArray(std::string_view dtype, bool masked);
+
+  void reserve(size_t size);
+
+  void push(nb::handle value);
+  void push_integer(std::int64_t value);
+  void push_real(double value);
+
+  // Append a value that doesn't fit, like a string or null.
+  void mismatch();
+
+  // Return the array, or a tuple of the array and an array.array of type "B"
+  // with a one for each masked value, if the array is masked.
+  nb::object to_python() const;
+
+private:
+  char m_typecode;
+  size_t m_itemsize;
+  bool m_masked;
+  size_t m_size{0};
+  std::vector<unsigned char> m_data{};
+  std::vector<unsigned char> m_mask{};
+
+  bool real() const { return m_typecode == 'f' || m_typecode == 'd'; }
+
+  template <typename T>
+  void append(T value);
+
+  void push_unsigned(std::uint64_t value);
+};
+
+}  // namespace libjsonpath
+
+#endif
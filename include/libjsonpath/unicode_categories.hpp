@@ -0,0 +1,15 @@
+#ifndef LIBJSONPATH_UNICODE_CATEGORIES_H
+#define LIBJSONPATH_UNICODE_CATEGORIES_H
+
+#include <string_view>  // std::string_view
+
+namespace libjsonpath {
+
+// The two letter Unicode general category of _c_, like "Lu", from a static
+// table generated by scripts/generate_unicode_categories.py. Code points
+// outside the Unicode range are "Cn", like unassigned ones.
+std::string_view general_category(char32_t c);
+
+}  // namespace libjsonpath
+
+#endif
@@ -46,6 +46,20 @@ COMPILE_AND_FIND_VALUES_STMT = """\
 for path, data in QUERIES:
     findall(path, data)"""
 
+COMPILE_AND_FIND_NO_CACHE_SETUP = """\
+from jsonpath24 import JSONPathEnvironment
+env = JSONPathEnvironment(cache_size=0)
+"""
+
+COMPILE_AND_FIND_CACHED_SETUP = """\
+from jsonpath24 import JSONPathEnvironment
+env = JSONPathEnvironment(cache_size=len(QUERIES))
+"""
+
+COMPILE_AND_FIND_ENV_STMT = """\
+for path, data in QUERIES:
+    env.query(path, data)"""
+
 JUST_COMPILE_SETUP = "from jsonpath24 import compile"
 
 JUST_COMPILE_STMT = """\
@@ -89,6 +103,26 @@ def benchmark(number: int = 100, best_of: int = 3) -> None:
 
     print("compile and find (values)".ljust(30), f"{min(results):.3f}")
 
+    results = timeit.repeat(
+        COMPILE_AND_FIND_ENV_STMT,
+        setup=COMPILE_AND_FIND_NO_CACHE_SETUP,
+        globals={"QUERIES": QUERIES},
+        number=number,
+        repeat=best_of,
+    )
+
+    print("compile and find (no cache)".ljust(30), f"{min(results):.3f}")
+
+    results = timeit.repeat(
+        COMPILE_AND_FIND_ENV_STMT,
+        setup=COMPILE_AND_FIND_CACHED_SETUP,
+        globals={"QUERIES": QUERIES},
+        number=number,
+        repeat=best_of,
+    )
+
+    print("compile and find (cached)".ljust(30), f"{min(results):.3f}")
+
     results = timeit.repeat(
         JUST_COMPILE_STMT,
         setup=JUST_COMPILE_SETUP,
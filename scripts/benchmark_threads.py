@@ -0,0 +1,69 @@
+import json
+import sys
+import sysconfig
+import time
+from concurrent.futures import ThreadPoolExecutor
+from typing import Any
+from typing import Mapping
+from typing import NamedTuple
+from typing import Sequence
+from typing import Union
+
+from jsonpath24 import compile
+
+# ruff: noqa: D100 D101 D103 T201 A004
+
+
+class CTSCase(NamedTuple):
+    query: str
+    data: Union[Sequence[Any], Mapping[str, Any]]
+
+
+def valid_queries() -> Sequence[CTSCase]:
+    with open("tests/cts/cts.json") as fd:
+        data = json.load(fd)
+
+    return [
+        (CTSCase(t["selector"], t["document"]))
+        for t in data["tests"]
+        if not t.get("invalid_selector", False)
+    ]
+
+
+QUERIES = [(compile(q), d) for q, d in valid_queries()]
+
+
+def work(number: int) -> None:
+    for _ in range(number):
+        for path, data in QUERIES:
+            path.findall(data)
+
+
+def benchmark(number: int = 100, max_threads: int = 8) -> None:
+    gil = getattr(sys, "_is_gil_enabled", lambda: True)()
+    print(
+        f"repeating {len(QUERIES)} queries {number} times per thread, "
+        f"Py_GIL_DISABLED={sysconfig.get_config_var('Py_GIL_DISABLED')}, "
+        f"GIL enabled={gil}"
+    )
+
+    baseline = 0.0
+    threads = 1
+    while threads <= max_threads:
+        with ThreadPoolExecutor(max_workers=threads) as executor:
+            start = time.perf_counter()
+            for future in [executor.submit(work, number) for _ in range(threads)]:
+                future.result()
+            elapsed = time.perf_counter() - start
+
+        throughput = threads * number / elapsed
+        baseline = baseline or throughput
+        print(
+            f"{threads} thread(s)".ljust(30),
+            f"{throughput:.1f} rounds/s ({throughput / baseline:.2f}x)",
+        )
+        threads *= 2
+
+
+if __name__ == "__main__":
+    benchmark()
@@ -0,0 +1,98 @@
+"""Generate src/libjsonpath/unicode_categories.cpp from unicodedata.
+
+Run from the repository root with the Python whose Unicode version the table
+should follow.
+"""
+
+import sys
+import unicodedata
+from typing import List
+from typing import Tuple
+
+# ruff: noqa: T201
+
+CATEGORIES = [
+    "Lu", "Ll", "Lt", "Lm", "Lo", "Mn", "Mc", "Me", "Nd", "Nl", "No", "Pc",
+    "Pd", "Ps", "Pe", "Pi", "Pf", "Po", "Sm", "Sc", "Sk", "So", "Zs", "Zl",
+    "Zp", "Cc", "Cf", "Cs", "Co", "Cn",
+]  # fmt: skip
+
+OUTPUT = "src/libjsonpath/unicode_categories.cpp"
+
+
+def runs() -> List[Tuple[int, str]]:
+    rv: List[Tuple[int, str]] = []
+    for c in range(sys.maxunicode + 1):
+        category = unicodedata.category(chr(c))
+        if not rv or rv[-1][1] != category:
+            rv.append((c, category))
+    return rv
+
+
+def wrap(entries: List[str]) -> str:
+    lines = []
+    line = " "
+    for entry in entries:
+        if len(line) + len(entry) + 1 > 80:  # noqa: PLR2004
+            lines.append(line)
+            line = " "
+        line += " " + entry
+    lines.append(line)
+    return "\n".join(lines)
+
+
+def main() -> None:
+    ranges = runs()
+    entries = wrap([f"{{0x{c:04X}, {CATEGORIES.index(cat)}}}," for c, cat in ranges])
+    names = wrap([f'"{name}",' for name in CATEGORIES])
+
+    with open(OUTPUT, "w") as fd:
+        fd.write(f"""\
+// Generated by scripts/generate_unicode_categories.py from Unicode
+// {unicodedata.unidata_version}. Do not edit.
+
+#include "libjsonpath/unicode_categories.hpp"
+
+#include <algorithm>    // std::upper_bound
+#include <cstdint>      // std::uint8_t
+#include <iterator>     // std::begin std::end
+#include <string_view>  // std::string_view
+
+namespace libjsonpath {{
+
+namespace {{
+
+constexpr std::string_view names[] = {{
+{names}
+}};
+
+struct Range {{
+  char32_t first;
+  std::uint8_t category;
+}};
+
+// The first code point of each run of code points with the same category.
+constexpr Range ranges[] = {{
+{entries}
+}};
+
+}}  // namespace
+
+std::string_view general_category(char32_t c) {{
+  auto it{{std::upper_bound(
+      std::begin(ranges), std::end(ranges), c,
+      [](char32_t c_, const Range& range) {{ return c_ < range.first; }})}};
+  if (it == std::begin(ranges) || c > 0x10FFFF) {{
+    return "Cn";
+  }}
+  return names[(it - 1)->category];
+}}
+
+}}  // namespace libjsonpath
+""")
+
+    print(f"wrote {len(ranges)} ranges to {OUTPUT}")
+
+
+if __name__ == "__main__":
+    main()
@@ -1,9 +1,14 @@
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "libjsonpath/cache.hpp"
+#include "libjsonpath/document.hpp"
 #include "libjsonpath/exceptions.hpp"
+#include "libjsonpath/iregexp.hpp"
 #include "libjsonpath/jsonpath.hpp"
 #include "libjsonpath/lex.hpp"
 #include "libjsonpath/node.hpp"
@@ -16,6 +21,7 @@
 #include "nanobind/stl/bind_map.h"
 #include "nanobind/stl/bind_vector.h"
 #include "nanobind/stl/map.h"
+#include "nanobind/stl/optional.h"
 #include "nanobind/stl/string.h"
 #include "nanobind/stl/string_view.h"
 #include "nanobind/stl/unordered_map.h"
@@ -41,6 +47,7 @@ NB_MODULE(_jsonpath24, m) {
   nb::exception<libjsonpath::IndexError>(m, "JSONPathIndexError", base_exception.ptr());
   nb::exception<libjsonpath::NameError>(m, "JSONPathNameError", base_exception.ptr());
   nb::exception<libjsonpath::EncodingError>(m, "JSONPathEncodingError", base_exception.ptr());
+  nb::exception<libjsonpath::JSONDecodeError>(m, "JSONDocumentError", PyExc_ValueError);
 
   nb::enum_<libjsonpath::TokenType>(m, "TokenType")
       .value("eof_", libjsonpath::TokenType::eof_)
@@ -252,6 +259,38 @@ NB_MODULE(_jsonpath24, m) {
       .def_ro("args", &libjsonpath::FunctionExtensionTypes::args)
       .def_ro("res", &libjsonpath::FunctionExtensionTypes::res);
 
+  nb::enum_<libjsonpath::NativeFunction>(m, "NativeFunction")
+      .value("none", libjsonpath::NativeFunction::none)
+      .value("count", libjsonpath::NativeFunction::count)
+      .value("length", libjsonpath::NativeFunction::length)
+      .value("value", libjsonpath::NativeFunction::value)
+      .value("match", libjsonpath::NativeFunction::match)
+      .value("search", libjsonpath::NativeFunction::search);
+
+  m.def("register_native_function", &libjsonpath::register_native_function,
+        nb::arg("type"), nb::arg("kind"),
+        "Use a native implementation for filter functions of exactly _type_");
+
+  m.def(
+      "iregexp_match",
+      [](nb::handle string, nb::handle pattern) {
+        auto regexp{libjsonpath::IRegexp::cached(pattern)};
+        return regexp && nb::isinstance<nb::str>(string) &&
+               regexp->match(string);
+      },
+      nb::arg("string"), nb::arg("pattern"),
+      "Return True if all of _string_ matches the I-Regexp _pattern_");
+
+  m.def(
+      "iregexp_search",
+      [](nb::handle string, nb::handle pattern) {
+        auto regexp{libjsonpath::IRegexp::cached(pattern)};
+        return regexp && nb::isinstance<nb::str>(string) &&
+               regexp->search(string);
+      },
+      nb::arg("string"), nb::arg("pattern"),
+      "Return True if any part of _string_ matches the I-Regexp _pattern_");
+
   m.def("parse", nb::overload_cast<std::string_view>(&libjsonpath::parse),
         "Parse a JSONPath query string", nb::rv_policy::move);
 
@@ -269,28 +308,253 @@ NB_MODULE(_jsonpath24, m) {
 
   nb::class_<libjsonpath::JSONPathNode>(m, "JSONPathNode")
       .def_ro("value", &libjsonpath::JSONPathNode::value)
-      .def_ro("location", &libjsonpath::JSONPathNode::location)
+      .def_prop_ro("location", &libjsonpath::JSONPathNode::location)
       .def("path", &libjsonpath::JSONPathNode::path);
 
   m.def("query_",
         nb::overload_cast<const libjsonpath::segments_t&, nb::object,
-                          libjsonpath::function_extension_map,
-                          libjsonpath::function_signature_map, nb::object>(
+                          const libjsonpath::function_extension_map&,
+                          const libjsonpath::function_signature_map&,
+                          nb::object>(
             &libjsonpath::query_),
         "Query JSON-like data", nb::rv_policy::move);
 
   m.def("query_",
         nb::overload_cast<std::string_view, nb::object,
-                          libjsonpath::function_extension_map,
-                          libjsonpath::function_signature_map, nb::object>(
+                          const libjsonpath::function_extension_map&,
+                          const libjsonpath::function_signature_map&,
+                          nb::object>(
             &libjsonpath::query_),
         "Query JSON-like data", nb::rv_policy::move);
 
+  nb::class_<libjsonpath::CacheInfo>(m, "CacheInfo")
+      .def_ro("hits", &libjsonpath::CacheInfo::hits)
+      .def_ro("misses", &libjsonpath::CacheInfo::misses)
+      .def_ro("evictions", &libjsonpath::CacheInfo::evictions)
+      .def_ro("maxsize", &libjsonpath::CacheInfo::maxsize)
+      .def_ro("currsize", &libjsonpath::CacheInfo::currsize)
+      .def("__repr__", [](const libjsonpath::CacheInfo& info) {
+        return "CacheInfo(hits=" + std::to_string(info.hits) +
+               ", misses=" + std::to_string(info.misses) +
+               ", evictions=" + std::to_string(info.evictions) +
+               ", maxsize=" + std::to_string(info.maxsize) +
+               ", currsize=" + std::to_string(info.currsize) + ")";
+      });
+
+  nb::class_<libjsonpath::JSONDocument>(m, "JSONDocument")
+      .def(
+          "__init__",
+          [](libjsonpath::JSONDocument* doc, nb::handle data) {
+            new (doc) libjsonpath::JSONDocument{
+                libjsonpath::JSONDocument::from_python(data)};
+          },
+          nb::arg("data"),
+          "Parse JSON from a str or a bytes-like object")
+      .def(
+          "value",
+          [](const libjsonpath::JSONDocument& doc) {
+            return doc.to_python(libjsonpath::JSONDocument::root);
+          },
+          "Convert the whole document to Python objects, like json.loads")
+      .def("__len__", &libjsonpath::JSONDocument::size);
+
   nb::class_<libjsonpath::Env_>(m, "Env_")
       .def(nb::init<libjsonpath::function_extension_map,
-                    libjsonpath::function_signature_map, nb::object>())
-      .def("query", &libjsonpath::Env_::query, nb::rv_policy::move)
+                    libjsonpath::function_signature_map, nb::object, size_t,
+                    size_t, size_t>(),
+           nb::arg("functions"), nb::arg("signatures"), nb::arg("nothing"),
+           nb::arg("cache_size") = libjsonpath::Env_::default_cache_size,
+           nb::arg("parallel_threshold") = 0, nb::arg("threads") = 0)
+      .def("register_function", &libjsonpath::Env_::register_function,
+           nb::arg("name"), nb::arg("func"), nb::arg("signature"),
+           "Add or replace a function extension and clear the query cache")
+      .def("query",
+           nb::overload_cast<std::string_view,
+                             const libjsonpath::JSONDocument&>(
+               &libjsonpath::Env_::query),
+           nb::rv_policy::move)
+      .def("query",
+           nb::overload_cast<std::string_view, nb::object>(
+               &libjsonpath::Env_::query),
+           nb::rv_policy::move)
       .def("from_segments", &libjsonpath::Env_::from_segments,
            nb::rv_policy::move)
-      .def("parse", &libjsonpath::Env_::parse, nb::rv_policy::move);
+      .def("findall",
+           nb::overload_cast<std::string_view,
+                             const libjsonpath::JSONDocument&>(
+               &libjsonpath::Env_::findall),
+           "Query a parsed JSON document, returning a list of values")
+      .def("findall",
+           nb::overload_cast<std::string_view, nb::object>(
+               &libjsonpath::Env_::findall),
+           "Query JSON-like data, returning a list of values")
+      .def("findall_array",
+           nb::overload_cast<std::string_view,
+                             const libjsonpath::JSONDocument&,
+                             std::string_view, bool>(
+               &libjsonpath::Env_::findall_array),
+           nb::arg("path"), nb::arg("data"), nb::arg("dtype") = "d",
+           nb::arg("masked") = false,
+           "Query a parsed JSON document, returning values in an "
+           "array.array")
+      .def("findall_array",
+           nb::overload_cast<std::string_view, nb::object, std::string_view,
+                             bool>(&libjsonpath::Env_::findall_array),
+           nb::arg("path"), nb::arg("data"), nb::arg("dtype") = "d",
+           nb::arg("masked") = false,
+           "Query JSON-like data, returning values in an array.array")
+      .def("findall_json",
+           nb::overload_cast<std::string_view,
+                             const libjsonpath::JSONDocument&>(
+               &libjsonpath::Env_::findall_json),
+           "Query a parsed JSON document, returning values as JSON bytes")
+      .def("findall_json",
+           nb::overload_cast<std::string_view, nb::object>(
+               &libjsonpath::Env_::findall_json),
+           "Query JSON-like data, returning values as JSON bytes")
+      .def("query_json",
+           nb::overload_cast<std::string_view,
+                             const libjsonpath::JSONDocument&>(
+               &libjsonpath::Env_::query_json),
+           "Query a parsed JSON document, returning paths and values as JSON "
+           "bytes")
+      .def("query_json",
+           nb::overload_cast<std::string_view, nb::object>(
+               &libjsonpath::Env_::query_json),
+           "Query JSON-like data, returning paths and values as JSON bytes")
+      .def("get",
+           nb::overload_cast<std::string_view, nb::object>(
+               &libjsonpath::Env_::get),
+           "Return the value of the first node matching a query, or nothing")
+      .def("query_one",
+           nb::overload_cast<std::string_view, nb::object>(
+               &libjsonpath::Env_::query_one),
+           "Return the first node matching a query, or None",
+           nb::rv_policy::move)
+      .def("parse", &libjsonpath::Env_::parse, nb::rv_policy::move)
+      .def("compile",
+           nb::overload_cast<std::string_view>(&libjsonpath::Env_::compile),
+           "Parse a JSONPath query string into a reusable compiled query",
+           nb::keep_alive<0, 1>())
+      .def("compile",
+           nb::overload_cast<const libjsonpath::segments_t&>(
+               &libjsonpath::Env_::compile),
+           "Compile parsed JSONPath segments into a reusable query",
+           nb::keep_alive<0, 1>())
+      .def("query_set", &libjsonpath::Env_::query_set,
+           "Parse JSONPath query strings into a set of queries that are "
+           "applied together",
+           nb::keep_alive<0, 1>())
+      .def("finditer",
+           nb::overload_cast<std::string_view, nb::object>(
+               &libjsonpath::Env_::finditer),
+           "Lazily query JSON-like data, one node at a time",
+           nb::keep_alive<0, 1>())
+      .def("query_ndjson", &libjsonpath::Env_::query_ndjson, nb::arg("query"),
+           nb::arg("path"), nb::arg("threads") = 0, nb::arg("ordered") = true,
+           "Query each line of a newline-delimited JSON file, yielding "
+           "(line number, nodes) for lines with matches",
+           nb::keep_alive<0, 1>())
+      .def("findall_ndjson", &libjsonpath::Env_::findall_ndjson,
+           nb::arg("query"), nb::arg("path"), nb::arg("threads") = 0,
+           nb::arg("ordered") = true,
+           "Query each line of a newline-delimited JSON file, yielding "
+           "(line number, values) for lines with matches",
+           nb::keep_alive<0, 1>())
+      .def("cache_info", &libjsonpath::Env_::cache_info,
+           "Query cache statistics")
+      .def("cache_clear", &libjsonpath::Env_::cache_clear,
+           "Remove all queries from the query cache and reset statistics");
+
+  nb::class_<libjsonpath::NodeIterator>(m, "NodeIterator")
+      .def("__iter__",
+           [](libjsonpath::NodeIterator& it) -> libjsonpath::NodeIterator& {
+             return it;
+           },
+           nb::rv_policy::reference)
+      .def("__next__", [](libjsonpath::NodeIterator& it) {
+        auto node{it.next()};
+        if (!node) {
+          throw nb::stop_iteration();
+        }
+        return std::move(*node);
+      });
+
+  nb::class_<libjsonpath::NDJSONIterator>(m, "NDJSONIterator")
+      .def("__iter__",
+           [](libjsonpath::NDJSONIterator& it)
+               -> libjsonpath::NDJSONIterator& { return it; },
+           nb::rv_policy::reference)
+      .def("__next__", [](libjsonpath::NDJSONIterator& it) {
+        auto line{it.next()};
+        if (!line) {
+          throw nb::stop_iteration();
+        }
+        if (it.values()) {
+          return nb::make_tuple(line->line, std::move(line->values));
+        }
+        return nb::make_tuple(line->line, std::move(line->nodes));
+      });
+
+  nb::class_<libjsonpath::CompiledQuery>(m, "CompiledQuery")
+      .def("query",
+           nb::overload_cast<const libjsonpath::JSONDocument&>(
+               &libjsonpath::CompiledQuery::query, nb::const_),
+           nb::rv_policy::move)
+      .def("query",
+           nb::overload_cast<nb::object>(&libjsonpath::CompiledQuery::query,
+                                         nb::const_),
+           nb::rv_policy::move)
+      .def("finditer", &libjsonpath::CompiledQuery::finditer,
+           nb::keep_alive<0, 1>())
+      .def("findall",
+           nb::overload_cast<const libjsonpath::JSONDocument&>(
+               &libjsonpath::CompiledQuery::findall, nb::const_))
+      .def("findall",
+           nb::overload_cast<nb::object>(&libjsonpath::CompiledQuery::findall,
+                                         nb::const_))
+      .def("findall_array",
+           nb::overload_cast<const libjsonpath::JSONDocument&,
+                             std::string_view, bool>(
+               &libjsonpath::CompiledQuery::findall_array, nb::const_),
+           nb::arg("data"), nb::arg("dtype") = "d", nb::arg("masked") = false)
+      .def("findall_array",
+           nb::overload_cast<nb::object, std::string_view, bool>(
+               &libjsonpath::CompiledQuery::findall_array, nb::const_),
+           nb::arg("data"), nb::arg("dtype") = "d", nb::arg("masked") = false)
+      .def("findall_json",
+           nb::overload_cast<const libjsonpath::JSONDocument&>(
+               &libjsonpath::CompiledQuery::findall_json, nb::const_))
+      .def("findall_json",
+           nb::overload_cast<nb::object>(
+               &libjsonpath::CompiledQuery::findall_json, nb::const_))
+      .def("query_json",
+           nb::overload_cast<const libjsonpath::JSONDocument&>(
+               &libjsonpath::CompiledQuery::query_json, nb::const_))
+      .def("query_json",
+           nb::overload_cast<nb::object>(
+               &libjsonpath::CompiledQuery::query_json, nb::const_))
+      .def("get", &libjsonpath::CompiledQuery::get)
+      .def("query_one", &libjsonpath::CompiledQuery::query_one,
+           nb::rv_policy::move)
+      .def("query_ndjson", &libjsonpath::CompiledQuery::query_ndjson,
+           nb::arg("path"), nb::arg("threads") = 0, nb::arg("ordered") = true,
+           nb::keep_alive<0, 1>())
+      .def("findall_ndjson", &libjsonpath::CompiledQuery::findall_ndjson,
+           nb::arg("path"), nb::arg("threads") = 0, nb::arg("ordered") = true,
+           nb::keep_alive<0, 1>())
+      .def_prop_ro("path", &libjsonpath::CompiledQuery::path)
+      .def("segments", &libjsonpath::CompiledQuery::segments,
+           "Copy this query's syntax tree to Python objects",
+           nb::rv_policy::copy)
+      .def("__str__", [](const libjsonpath::CompiledQuery& q) {
+        return libjsonpath::to_string(q.segments());
+      });
+
+  nb::class_<libjsonpath::CompiledQuerySet>(m, "CompiledQuerySet")
+      .def("query", &libjsonpath::CompiledQuerySet::query,
+           nb::rv_policy::move)
+      .def("findall", &libjsonpath::CompiledQuerySet::findall)
+      .def("paths", &libjsonpath::CompiledQuerySet::paths)
+      .def("__len__", &libjsonpath::CompiledQuerySet::size);
 }
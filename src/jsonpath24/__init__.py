@@ -1,5 +1,8 @@
 from ._jsonpath24 import BinaryOperator
 from ._jsonpath24 import BooleanLiteral
+from ._jsonpath24 import CacheInfo
+from ._jsonpath24 import CompiledQuery
+from ._jsonpath24 import CompiledQuerySet
 from ._jsonpath24 import Env_
 from ._jsonpath24 import ExpressionType
 from ._jsonpath24 import FilterSelector
@@ -11,6 +14,8 @@ from ._jsonpath24 import FunctionSignatureMap
 from ._jsonpath24 import IndexSelector
 from ._jsonpath24 import InfixExpression
 from ._jsonpath24 import IntegerLiteral
+from ._jsonpath24 import JSONDocument
+from ._jsonpath24 import JSONDocumentError
 from ._jsonpath24 import JSONPathException
 from ._jsonpath24 import JSONPathLexerError
 from ._jsonpath24 import JSONPathNode
@@ -18,7 +23,10 @@ from ._jsonpath24 import JSONPathSyntaxError
 from ._jsonpath24 import JSONPathTypeError
 from ._jsonpath24 import Lexer
 from ._jsonpath24 import LogicalNotExpression
+from ._jsonpath24 import NodeIterator
 from ._jsonpath24 import NameSelector
+from ._jsonpath24 import NDJSONIterator
+from ._jsonpath24 import NativeFunction
 from ._jsonpath24 import NullLiteral
 from ._jsonpath24 import Parser
 from ._jsonpath24 import RecursiveSegment
@@ -30,8 +38,11 @@ from ._jsonpath24 import StringLiteral
 from ._jsonpath24 import Token
 from ._jsonpath24 import TokenType
 from ._jsonpath24 import WildSelector
+from ._jsonpath24 import iregexp_match
+from ._jsonpath24 import iregexp_search
 from ._jsonpath24 import parse
 from ._jsonpath24 import query_
+from ._jsonpath24 import register_native_function
 from ._jsonpath24 import singular_query
 from ._jsonpath24 import to_string
 
@@ -40,26 +51,39 @@ from ._nothing import Nothing
 from ._nothing import NOTHING
 from .filter_function import FilterFunction
 from ._path import JSONPath
+from ._query_set import QuerySet
 from ._env import JSONPathEnvironment
 
 __all__ = (
     "__version__",
     "BinaryOperator",
     "BooleanLiteral",
+    "CacheInfo",
     "compile",
+    "CompiledQuery",
+    "CompiledQuerySet",
     "Env_",
     "ExpressionType",
     "FilterFunction",
     "FilterSelector",
     "findall",
+    "findall_array",
+    "findall_json",
+    "findall_ndjson",
+    "finditer",
     "FloatLiteral",
     "FunctionCall",
     "FunctionExtensionMap",
     "FunctionExtensionTypes",
     "FunctionSignatureMap",
+    "get",
     "IndexSelector",
     "InfixExpression",
     "IntegerLiteral",
+    "iregexp_match",
+    "iregexp_search",
+    "JSONDocument",
+    "JSONDocumentError",
     "JSONPath",
     "JSONPathEnvironment",
     "JSONPathException",
@@ -70,13 +94,21 @@ __all__ = (
     "Lexer",
     "LogicalNotExpression",
     "NameSelector",
+    "NativeFunction",
+    "NDJSONIterator",
+    "NodeIterator",
     "NOTHING",
     "Nothing",
     "NullLiteral",
     "parse",
     "Parser",
     "query_",
+    "query_json",
+    "query_ndjson",
+    "query_one",
+    "QuerySet",
     "RecursiveSegment",
+    "register_native_function",
     "RelativeQuery",
     "RootQuery",
     "Segment",
@@ -92,4 +124,12 @@ __all__ = (
 DEFAULT_ENV = JSONPathEnvironment()
 compile = DEFAULT_ENV.compile  # noqa: A001
 findall = DEFAULT_ENV.findall
+findall_array = DEFAULT_ENV.findall_array
+findall_json = DEFAULT_ENV.findall_json
+findall_ndjson = DEFAULT_ENV.findall_ndjson
+finditer = DEFAULT_ENV.finditer
+get = DEFAULT_ENV.get
 query = DEFAULT_ENV.query
+query_json = DEFAULT_ENV.query_json
+query_ndjson = DEFAULT_ENV.query_ndjson
+query_one = DEFAULT_ENV.query_one
@@ -1,13 +1,19 @@
-from enum import Enum  # noqa: I001
+from array import array  # noqa: I001
+from enum import Enum
+from os import PathLike
+from typing import Any
 from typing import Dict
+from typing import Iterator
 from typing import List
 from typing import Optional
 from typing import Sequence
+from typing import Tuple
 from typing import Union
 from typing import overload
 
 from ._env import JSONPathEnvironment
 from ._path import JSONPath
+from ._query_set import QuerySet
 from ._nothing import NOTHING
 from ._nothing import Nothing
 from .filter_function import FilterFunction
@@ -15,19 +21,31 @@ from .filter_function import FilterFunction
 __all__ = (
     "BinaryOperator",
     "BooleanLiteral",
+    "CacheInfo",
     "compile",
+    "CompiledQuery",
+    "CompiledQuerySet",
     "ExpressionType",
     "FilterFunction",
     "FilterSelector",
     "findall",
+    "findall_array",
+    "findall_json",
+    "findall_ndjson",
+    "finditer",
     "FloatLiteral",
     "FunctionCall",
     "FunctionExtensionMap",
     "FunctionExtensionTypes",
     "FunctionSignatureMap",
+    "get",
     "IndexSelector",
     "InfixExpression",
     "IntegerLiteral",
+    "iregexp_match",
+    "iregexp_search",
+    "JSONDocument",
+    "JSONDocumentError",
     "JSONPath",
     "JSONPathEnvironment",
     "JSONPathException",
@@ -38,13 +56,21 @@ __all__ = (
     "Lexer",
     "LogicalNotExpression",
     "NameSelector",
+    "NativeFunction",
+    "NDJSONIterator",
+    "NodeIterator",
     "NOTHING",
     "Nothing",
     "NullLiteral",
     "parse",
     "Parser",
     "query_",
+    "query_json",
+    "query_ndjson",
+    "query_one",
+    "QuerySet",
     "RecursiveSegment",
+    "register_native_function",
     "RelativeQuery",
     "RootQuery",
     "Segment",
@@ -58,12 +84,19 @@ __all__ = (
     "query",
     "compile",
     "findall",
+    "finditer",
 )
 
 class JSONPathException(Exception): ...  # noqa: N818
 class JSONPathLexerError(JSONPathException): ...
 class JSONPathSyntaxError(JSONPathException): ...
 class JSONPathTypeError(JSONPathException): ...
+class JSONDocumentError(ValueError): ...
+
+class JSONDocument:
+    def __init__(self, data: Union[str, bytes, bytearray, memoryview]) -> None: ...
+    def value(self) -> object: ...
+    def __len__(self) -> int: ...
 
 class TokenType(Enum):
     eof_ = ...
@@ -149,6 +182,18 @@ class ExpressionType(Enum):
     logical = ...
     nodes = ...
 
+class NativeFunction(Enum):
+    none = ...
+    count = ...
+    length = ...
+    value = ...
+    match = ...
+    search = ...
+
+def register_native_function(type: type, kind: NativeFunction) -> None: ...  # noqa: A002
+def iregexp_match(string: object, pattern: object) -> bool: ...
+def iregexp_search(string: object, pattern: object) -> bool: ...
+
 Segments = Sequence[Union["Segment", "RecursiveSegment"]]
 
 Selector = Union[
@@ -297,6 +342,14 @@ class JSONPathNode:
 
 JSONPathNodeList = Sequence[JSONPathNode]
 
+class NodeIterator(Iterator[JSONPathNode]):
+    def __iter__(self) -> NodeIterator: ...
+    def __next__(self) -> JSONPathNode: ...
+
+class NDJSONIterator(Iterator[Tuple[int, List[object]]]):
+    def __iter__(self) -> NDJSONIterator: ...
+    def __next__(self) -> Tuple[int, List[object]]: ...
+
 class FunctionExtensionMap(Dict[str, FilterFunction]): ...
 class FunctionSignatureMap(Dict[str, FunctionExtensionTypes]): ...
 
@@ -317,17 +370,106 @@ def query_(
     nothing: object,
 ) -> List[JSONPathNode]: ...
 
+class CacheInfo:
+    @property
+    def hits(self) -> int: ...
+    @property
+    def misses(self) -> int: ...
+    @property
+    def evictions(self) -> int: ...
+    @property
+    def maxsize(self) -> int: ...
+    @property
+    def currsize(self) -> int: ...
+
 class Env_:  # noqa: N801
     def __init__(
         self,
         functions: FunctionExtensionMap,
         signatures: FunctionSignatureMap,
         nothing: object,
+        cache_size: int = ...,
+        parallel_threshold: int = ...,
+        threads: int = ...,
+    ) -> None: ...
+    def register_function(
+        self, name: str, func: FilterFunction, signature: FunctionExtensionTypes
     ) -> None: ...
     def query(self, path: str, data: object) -> List[JSONPathNode]: ...
     def from_segments(self, segments: Segments, data: object) -> List[JSONPathNode]: ...
+    def findall(self, path: str, data: object) -> List[object]: ...
+    def findall_array(
+        self, path: str, data: object, dtype: str = ..., masked: bool = ...
+    ) -> Union[array[Any], Tuple[array[Any], array[int]]]: ...
+    def findall_json(self, path: str, data: object) -> bytes: ...
+    def query_json(self, path: str, data: object) -> bytes: ...
     def parse(self, path: str) -> Segments: ...
+    @overload
+    def compile(self, path: str) -> CompiledQuery: ...  # noqa: A003
+    @overload
+    def compile(self, path: Segments) -> CompiledQuery: ...  # noqa: A003
+    def query_set(self, paths: List[str]) -> CompiledQuerySet: ...
+    def finditer(self, path: str, data: object) -> NodeIterator: ...
+    def get(self, path: str, data: object) -> object: ...
+    def query_one(self, path: str, data: object) -> Optional[JSONPathNode]: ...
+    def query_ndjson(
+        self, query: str, path: str, threads: int = ..., ordered: bool = ...
+    ) -> NDJSONIterator: ...
+    def findall_ndjson(
+        self, query: str, path: str, threads: int = ..., ordered: bool = ...
+    ) -> NDJSONIterator: ...
+    def cache_info(self) -> CacheInfo: ...
+    def cache_clear(self) -> None: ...
+
+class CompiledQuery:
+    @property
+    def path(self) -> str: ...
+    def query(self, data: object) -> List[JSONPathNode]: ...
+    def finditer(self, data: object) -> NodeIterator: ...
+    def findall(self, data: object) -> List[object]: ...
+    def findall_array(
+        self, data: object, dtype: str = ..., masked: bool = ...
+    ) -> Union[array[Any], Tuple[array[Any], array[int]]]: ...
+    def findall_json(self, data: object) -> bytes: ...
+    def query_json(self, data: object) -> bytes: ...
+    def get(self, data: object) -> object: ...
+    def query_one(self, data: object) -> Optional[JSONPathNode]: ...
+    def query_ndjson(
+        self, path: str, threads: int = ..., ordered: bool = ...
+    ) -> NDJSONIterator: ...
+    def findall_ndjson(
+        self, path: str, threads: int = ..., ordered: bool = ...
+    ) -> NDJSONIterator: ...
+    def segments(self) -> Segments: ...
+
+class CompiledQuerySet:
+    def query(self, data: object) -> List[List[JSONPathNode]]: ...
+    def findall(self, data: object) -> List[List[object]]: ...
+    def paths(self) -> List[str]: ...
+    def __len__(self) -> int: ...
 
 def compile(path: str) -> JSONPath: ...  # noqa: A001
 def findall(path: str, data: object) -> List[object]: ...
+def findall_array(
+    path: str, data: object, dtype: str = ..., *, masked: bool = ...
+) -> Union[array[Any], Tuple[array[Any], array[int]]]: ...
+def findall_json(path: str, data: object) -> bytes: ...
+def finditer(path: str, data: object) -> Iterator[JSONPathNode]: ...
 def query(path: str, data: object) -> List[JSONPathNode]: ...
+def query_json(path: str, data: object) -> bytes: ...
+def get(path: str, data: object) -> object: ...
+def query_one(path: str, data: object) -> Optional[JSONPathNode]: ...
+def query_ndjson(
+    path: str,
+    file: Union[str, PathLike[str]],
+    *,
+    threads: int = ...,
+    ordered: bool = ...,
+) -> Iterator[Tuple[int, List[JSONPathNode]]]: ...
+def findall_ndjson(
+    path: str,
+    file: Union[str, PathLike[str]],
+    *,
+    threads: int = ...,
+    ordered: bool = ...,
+) -> Iterator[Tuple[int, List[object]]]: ...
@@ -1,9 +1,19 @@
 from __future__ import annotations
 
+import os
 from typing import TYPE_CHECKING
+from typing import Any
+from typing import Iterable
+from typing import Iterator
 from typing import List
+from typing import Optional
+from typing import Tuple
+from typing import Union
 
 if TYPE_CHECKING:
+    from array import array
+
+    from jsonpath24 import CacheInfo
     from jsonpath24 import FilterFunction
     from jsonpath24 import JSONPathNode
     from jsonpath24 import Segments
@@ -16,6 +26,7 @@ from jsonpath24 import FunctionSignatureMap
 
 from ._nothing import NOTHING
 from ._path import JSONPath
+from ._query_set import QuerySet
 from .functions import Count
 from .functions import Length
 from .functions import Match
@@ -24,27 +35,57 @@ from .functions import Value
 
 
 class JSONPathEnvironment:
-    __slots__ = ("_function_register", "_function_signatures", "_env")
+    """JSONPath configuration.
 
-    def __init__(self) -> None:
-        self._function_register = FunctionExtensionMap()
-        self._function_signatures = FunctionSignatureMap()
-        self.setup_function_register()
+    Args:
+        cache_size: The maximum number of parsed queries to keep in this
+            environment's least recently used query cache. A cache size of
+            zero disables query caching.
+        parallel_threshold: When querying a `JSONDocument`, apply wildcard,
+            slice and filter selectors to arrays with at least this many
+            items on a pool of threads, without holding the GIL. Zero, the
+            default, disables parallel evaluation.
+        threads: The number of threads to use for parallel evaluation, or
+            zero for one per CPU core. Threads are started by the first query
+            that needs them and kept for the lifetime of the environment.
+    """
+
+    __slots__ = (
+        "_env",
+        "_cache_size",
+        "_parallel_threshold",
+        "_threads",
+    )
+
+    def __init__(
+        self, *, cache_size: int = 256, parallel_threshold: int = 0, threads: int = 0
+    ) -> None:
+        self._cache_size = cache_size
+        self._parallel_threshold = parallel_threshold
+        self._threads = threads
         self._env = Env_(
-            self._function_register,
-            self._function_signatures,
+            FunctionExtensionMap(),
+            FunctionSignatureMap(),
             NOTHING,
+            self._cache_size,
+            self._parallel_threshold,
+            self._threads,
         )
+        self.setup_function_register()
 
     def register_function(self, name: str, func: FilterFunction) -> None:
-        self._function_register[name] = func
-        self._function_signatures[name] = FunctionExtensionTypes(
-            list(func.arg_types), func.return_type
-        )
-        self._env = Env_(
-            self._function_register,
-            self._function_signatures,
-            NOTHING,
+        """Add or replace a filter function extension.
+
+        Registering a function clears the query cache, as previously parsed
+        queries might have been validated against the old function signatures.
+        It is safe to register functions while other threads are querying with
+        this environment. Queries that have already started use the functions
+        they started with.
+        """
+        self._env.register_function(
+            name,
+            func,
+            FunctionExtensionTypes(list(func.arg_types), func.return_type),
         )
 
     def setup_function_register(self) -> None:
@@ -56,13 +97,124 @@ class JSONPathEnvironment:
         self.register_function("value", Value())
 
     def compile(self, path: str) -> JSONPath:  # noqa: A003
-        return JSONPath(self, self._env.parse(path))
+        return JSONPath(self, self._env.compile(path))
+
+    def query_set(self, paths: Iterable[str]) -> QuerySet:
+        """Compile _paths_ into a set of queries that are applied together."""
+        return QuerySet(self, self._env.query_set(list(paths)))
 
     def findall(self, path: str, data: object) -> List[object]:
-        return [node.value for node in self.query(path, data)]
+        """Return values matching _path_ in _data_.
+
+        _data_ can be a `JSONDocument`, in which case only matching values are
+        converted to Python objects.
+        """
+        return self._env.findall(path, data)
+
+    def findall_array(
+        self, path: str, data: object, dtype: str = "d", *, masked: bool = False
+    ) -> Union[array[Any], Tuple[array[Any], array[int]]]:
+        """Return values matching _path_ in _data_ as an `array.array`.
+
+        _dtype_ is a numeric `array` type code, like `"d"` or `"q"`, or a
+        NumPy style name, like `"float64"` or `"int32"`. The array supports
+        the buffer protocol, so it can be wrapped with `numpy.frombuffer`
+        without copying.
+
+        Matching ints and floats are written straight to the array. Floats
+        don't fit integer types, and ints must be in range. Any other value
+        raises a `TypeError`, unless _masked_ is True, in which case it is
+        stored as zero and an `array("B")` mask, with a one for each value
+        that didn't fit, is returned with the values.
+
+        Numbers in a `JSONDocument` are read without creating Python objects.
+        """
+        return self._env.findall_array(path, data, dtype, masked)
+
+    def findall_json(self, path: str, data: object) -> bytes:
+        """Return values matching _path_ in _data_ as a UTF-8 encoded JSON array.
+
+        The result is like `json.dumps(findall(path, data), ensure_ascii=False,
+        separators=(",", ":")).encode()`, but dicts, lists, strs, ints, floats,
+        bools and None are written without calling into Python. Lone
+        surrogates are written as `\\u` escapes.
+
+        Values in a `JSONDocument` are written without ever being converted
+        to Python objects.
+        """
+        return self._env.findall_json(path, data)
+
+    def query_json(self, path: str, data: object) -> bytes:
+        """Return nodes matching _path_ in _data_ as a UTF-8 encoded JSON array.
+
+        Like `findall_json`, but each node is written as an object with the
+        node's normalized path and its value, `{"path": ..., "value": ...}`.
+        """
+        return self._env.query_json(path, data)
 
     def query(self, path: str, data: object) -> List[JSONPathNode]:
         return self._env.query(path, data)
 
+    def get(self, path: str, data: object) -> object:
+        """Return the value of the first node matching _path_ in _data_.
+
+        Returns `NOTHING` if there are no matches. Singular queries, like
+        `$.a[0].b`, look up each name and index directly.
+        """
+        return self._env.get(path, data)
+
+    def query_one(self, path: str, data: object) -> Optional[JSONPathNode]:
+        """Return the first node matching _path_ in _data_, or None."""
+        return self._env.query_one(path, data)
+
+    def finditer(self, path: str, data: object) -> Iterator[JSONPathNode]:
+        """Generate nodes matching _path_ in _data_, one at a time."""
+        return self._env.finditer(path, data)
+
+    def query_ndjson(
+        self,
+        path: str,
+        file: Union[str, os.PathLike[str]],
+        *,
+        threads: int = 0,
+        ordered: bool = True,
+    ) -> Iterator[Tuple[int, List[JSONPathNode]]]:
+        """Apply _path_ to each line of the newline-delimited JSON _file_.
+
+        Yields a `(line_number, nodes)` tuple for every line with at least one
+        match. Line numbers start at one. Blank lines are skipped.
+
+        Lines are parsed on _threads_ worker threads, or one per CPU core if
+        _threads_ is zero. If _ordered_ is False, lines are yielded as soon as
+        they are ready rather than in file order.
+
+        Raises `JSONDocumentError` for a line that isn't valid JSON, after
+        yielding results for the lines before it.
+        """
+        return self._env.query_ndjson(
+            path, os.fspath(file), threads=threads, ordered=ordered
+        )
+
+    def findall_ndjson(
+        self,
+        path: str,
+        file: Union[str, os.PathLike[str]],
+        *,
+        threads: int = 0,
+        ordered: bool = True,
+    ) -> Iterator[Tuple[int, List[object]]]:
+        """Like `query_ndjson`, but yield `(line_number, values)` tuples."""
+        return self._env.findall_ndjson(
+            path, os.fspath(file), threads=threads, ordered=ordered
+        )
+
     def from_segments(self, segments: Segments, data: object) -> List[JSONPathNode]:
         return self._env.from_segments(segments, data)
+
+    def cache_info(self) -> CacheInfo:
+        """Return query cache hit, miss and eviction counts."""
+        return self._env.cache_info()
+
+    def cache_clear(self) -> None:
+        """Remove all parsed queries from the query cache and reset statistics."""
+        self._env.cache_clear()
@@ -1,40 +1,134 @@
 from __future__ import annotations
 
+import os
 from typing import TYPE_CHECKING
+from typing import Any
+from typing import Iterator
 from typing import List
+from typing import Optional
+from typing import Tuple
+from typing import Union
 
-from jsonpath24 import query_
-from jsonpath24 import to_string
-
-from ._nothing import NOTHING
+from jsonpath24 import CompiledQuery
 
 if TYPE_CHECKING:
+    from array import array
+
     from jsonpath24 import JSONPathEnvironment
     from jsonpath24 import JSONPathNode
     from jsonpath24 import Segments
 
 
 class JSONPath:
+    """A compiled JSONPath query, ready to be applied to some data.
+
+    The query's syntax tree is kept in C++. `segments` builds a Python view of
+    it on first access.
+
+    _query_ is usually a `CompiledQuery` from the environment, but segments
+    from `parse` are accepted too, and compiled with _environment_'s
+    function extensions.
+    """
+
     __slots__ = (
         "environment",
-        "segments",
+        "_query",
+        "_segments",
     )
 
-    def __init__(self, environment: JSONPathEnvironment, segments: Segments) -> None:
+    def __init__(
+        self,
+        environment: JSONPathEnvironment,
+        query: Union[CompiledQuery, Segments],
+    ) -> None:
         self.environment = environment
-        self.segments = segments
+        self._segments: Optional[Segments] = None
+        if isinstance(query, CompiledQuery):
+            self._query = query
+        else:
+            self._segments = query
+            self._query = environment._env.compile(query)  # noqa: SLF001
+
+    @property
+    def segments(self) -> Segments:
+        """This query's syntax tree."""
+        if self._segments is None:
+            self._segments = self._query.segments()
+        return self._segments
 
     def findall(self, data: object) -> List[object]:
-        return [node.value for node in self.query(data)]
+        return self._query.findall(data)
+
+    def findall_array(
+        self, data: object, dtype: str = "d", *, masked: bool = False
+    ) -> Union[array[Any], Tuple[array[Any], array[int]]]:
+        """Return values matching this query in _data_ as an `array.array`.
+
+        See `JSONPathEnvironment.findall_array`.
+        """
+        return self._query.findall_array(data, dtype, masked)
+
+    def findall_json(self, data: object) -> bytes:
+        """Return values matching this query in _data_ as JSON bytes.
+
+        See `JSONPathEnvironment.findall_json`.
+        """
+        return self._query.findall_json(data)
+
+    def query_json(self, data: object) -> bytes:
+        """Return paths and values matching this query in _data_ as JSON bytes.
+
+        See `JSONPathEnvironment.query_json`.
+        """
+        return self._query.query_json(data)
 
     def query(self, data: object) -> List[JSONPathNode]:
-        return query_(
-            self.segments,
-            data,
-            self.environment._function_register,  # noqa: SLF001
-            self.environment._function_signatures,  # noqa: SLF001
-            NOTHING,
+        return self._query.query(data)
+
+    def get(self, data: object) -> object:
+        """Return the value of the first node matching this query in _data_.
+
+        Returns `NOTHING` if there are no matches.
+        """
+        return self._query.get(data)
+
+    def query_one(self, data: object) -> Optional[JSONPathNode]:
+        """Return the first node matching this query in _data_, or None."""
+        return self._query.query_one(data)
+
+    def finditer(self, data: object) -> Iterator[JSONPathNode]:
+        """Generate nodes matching this query in _data_, one at a time."""
+        return self._query.finditer(data)
+
+    def query_ndjson(
+        self,
+        file: Union[str, os.PathLike[str]],
+        *,
+        threads: int = 0,
+        ordered: bool = True,
+    ) -> Iterator[Tuple[int, List[JSONPathNode]]]:
+        """Apply this query to each line of the newline-delimited JSON _file_.
+
+        See `JSONPathEnvironment.query_ndjson`.
+        """
+        return self._query.query_ndjson(
+            os.fspath(file), threads=threads, ordered=ordered
         )
 
+    def findall_ndjson(
+        self,
+        file: Union[str, os.PathLike[str]],
+        *,
+        threads: int = 0,
+        ordered: bool = True,
+    ) -> Iterator[Tuple[int, List[object]]]:
+        """Like `query_ndjson`, but yield `(line_number, values)` tuples."""
+        return self._query.findall_ndjson(
+            os.fspath(file), threads=threads, ordered=ordered
+        )
+
+    def __str__(self) -> str:
+        return str(self._query)
+
     def __repr__(self) -> str:
-        return f"<jsonpath24.JSONPath {to_string(self.segments)}>"
+        return f"<jsonpath24.JSONPath {self._query}>"
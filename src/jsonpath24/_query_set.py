@@ -0,0 +1,48 @@
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+from typing import List
+
+if TYPE_CHECKING:
+    from jsonpath24 import CompiledQuerySet
+    from jsonpath24 import JSONPathEnvironment
+    from jsonpath24 import JSONPathNode
+
+
+class QuerySet:
+    """Several compiled JSONPath queries, applied to the same data together.
+
+    Segments shared by the start of more than one query, like `$.meta` in
+    `$.meta.id` and `$.meta.tags[*]`, are evaluated once per document.
+    Results are the same as applying each query on its own.
+    """
+
+    __slots__ = (
+        "environment",
+        "_queries",
+    )
+
+    def __init__(
+        self, environment: JSONPathEnvironment, queries: CompiledQuerySet
+    ) -> None:
+        self.environment = environment
+        self._queries = queries
+
+    @property
+    def paths(self) -> List[str]:
+        """The query strings in this set, in the order they were given."""
+        return self._queries.paths()
+
+    def findall(self, data: object) -> List[List[object]]:
+        """Return a list of matching values for each query in this set."""
+        return self._queries.findall(data)
+
+    def query(self, data: object) -> List[List[JSONPathNode]]:
+        """Return a list of matching nodes for each query in this set."""
+        return self._queries.query(data)
+
+    def __len__(self) -> int:
+        return len(self._queries)
+
+    def __repr__(self) -> str:
+        return f"<jsonpath24.QuerySet {self.paths!r}>"
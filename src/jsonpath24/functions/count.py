@@ -5,6 +5,8 @@ from typing import TYPE_CHECKING
 
 from jsonpath24 import ExpressionType
 from jsonpath24 import FilterFunction
+from jsonpath24 import NativeFunction
+from jsonpath24 import register_native_function
 
 if TYPE_CHECKING:
     from jsonpath24 import JSONPathNodeList
@@ -19,3 +21,6 @@ class Count(FilterFunction):
     def __call__(self, node_list: JSONPathNodeList) -> int:
         """Return the number of nodes in the node list."""
         return len(node_list)
+
+
+register_native_function(Count, NativeFunction.count)
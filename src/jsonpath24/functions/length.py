@@ -6,7 +6,9 @@ from typing import Union
 from jsonpath24 import NOTHING
 from jsonpath24 import ExpressionType
 from jsonpath24 import FilterFunction
+from jsonpath24 import NativeFunction
 from jsonpath24 import Nothing
+from jsonpath24 import register_native_function
 
 
 class Length(FilterFunction):
@@ -21,3 +23,6 @@ class Length(FilterFunction):
             return len(obj)
         except TypeError:
             return NOTHING
+
+
+register_native_function(Length, NativeFunction.length)
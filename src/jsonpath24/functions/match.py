@@ -1,21 +1,26 @@
 """The standard `match` function extension."""
 
-import re
-
 from jsonpath24 import ExpressionType
 from jsonpath24 import FilterFunction
+from jsonpath24 import NativeFunction
+from jsonpath24 import iregexp_match
+from jsonpath24 import register_native_function
 
 
 class Match(FilterFunction):
-    """A type-aware implementation of the standard `match` function."""
+    """A type-aware implementation of the standard `match` function.
+
+    Calls to instances of this class are evaluated natively, with patterns
+    compiled as I-Regexp (RFC 9485). Subclasses are called from Python, but
+    use the same I-Regexp implementation, so they agree with the native one.
+    """
 
     arg_types = (ExpressionType.value, ExpressionType.value)
     return_type = ExpressionType.logical
 
     def __call__(self, string: str, pattern: str) -> bool:
         """Return `True` if _string_ matches _pattern_, or `False` otherwise."""
-        try:
-            # re.fullmatch caches compiled patterns internally
-            return bool(re.fullmatch(pattern, string))
-        except (TypeError, re.error):
-            return False
+        return iregexp_match(string, pattern)
+
+
+register_native_function(Match, NativeFunction.match)
@@ -1,21 +1,26 @@
 """The standard `search` function extension."""
 
-import re
-
 from jsonpath24 import ExpressionType
 from jsonpath24 import FilterFunction
+from jsonpath24 import NativeFunction
+from jsonpath24 import iregexp_search
+from jsonpath24 import register_native_function
 
 
 class Search(FilterFunction):
-    """A type-aware implementation of the standard `search` function."""
+    """A type-aware implementation of the standard `search` function.
+
+    Calls to instances of this class are evaluated natively, with patterns
+    compiled as I-Regexp (RFC 9485). Subclasses are called from Python, but
+    use the same I-Regexp implementation, so they agree with the native one.
+    """
 
     arg_types = (ExpressionType.value, ExpressionType.value)
     return_type = ExpressionType.logical
 
     def __call__(self, string: str, pattern: str) -> bool:
         """Return `True` if _string_ contains _pattern_, or `False` otherwise."""
-        try:
-            # re.search caches compiled patterns internally
-            return bool(re.search(pattern, string))
-        except (TypeError, re.error):
-            return False
+        return iregexp_search(string, pattern)
+
+
+register_native_function(Search, NativeFunction.search)
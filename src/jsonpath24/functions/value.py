@@ -6,6 +6,8 @@ from typing import TYPE_CHECKING
 from jsonpath24 import NOTHING
 from jsonpath24 import ExpressionType
 from jsonpath24 import FilterFunction
+from jsonpath24 import NativeFunction
+from jsonpath24 import register_native_function
 
 if TYPE_CHECKING:
     from jsonpath24 import JSONPathNodeList
@@ -22,3 +24,6 @@ class Value(FilterFunction):
         if len(nodes) == 1:
             return nodes[0].value
         return NOTHING
+
+
+register_native_function(Value, NativeFunction.value)
@@ -0,0 +1,643 @@
+#include "libjsonpath/document.hpp"
+
+#include <cstdint>        // std::int64_t std::uint32_t
+#include <limits>         // std::numeric_limits
+#include <string>         // std::string
+#include <string_view>    // std::string_view
+#include <unordered_set>  // std::unordered_set
+#include <utility>        // std::move
+#include <vector>         // std::vector
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+namespace {
+
+using Type = JSONDocument::Type;
+
+constexpr size_t max_length = std::numeric_limits<std::uint32_t>::max();
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+int hex_value(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// Append _c_ to _out_, UTF-8 encoded. Lone surrogates are encoded like any
+// other code point, so they can be decoded with Python's "surrogatepass"
+// error handler.
+void append_utf8(std::string& out, char32_t c) {
+  if (c < 0x80) {
+    out.push_back(static_cast<char>(c));
+  } else if (c < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+    out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  } else if (c < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  }
+}
+
+// Return the offset of the first byte of _text_ that isn't part of a valid
+// UTF-8 sequence, or the length of _text_ if it is all valid. Like Python's
+// strict UTF-8 codec, overlong encodings and surrogates are invalid.
+size_t invalid_utf8(std::string_view text) {
+  const auto* bytes{reinterpret_cast<const unsigned char*>(text.data())};
+  const size_t size{text.size()};
+  size_t i{0};
+  while (i < size) {
+    unsigned char c{bytes[i]};
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+
+    size_t length{0};
+    unsigned char low{0x80};
+    unsigned char high{0xBF};
+    if (c >= 0xC2 && c <= 0xDF) {
+      length = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+      length = 3;
+      if (c == 0xE0) {
+        low = 0xA0;
+      } else if (c == 0xED) {
+        high = 0x9F;
+      }
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      length = 4;
+      if (c == 0xF0) {
+        low = 0x90;
+      } else if (c == 0xF4) {
+        high = 0x8F;
+      }
+    } else {
+      return i;
+    }
+
+    if (size - i < length || bytes[i + 1] < low || bytes[i + 1] > high) {
+      return i;
+    }
+    for (size_t j = 2; j < length; j++) {
+      if ((bytes[i + j] & 0xC0) != 0x80) {
+        return i;
+      }
+    }
+    i += length;
+  }
+  return size;
+}
+
+}  // namespace
+
+// A non-recursive JSON parser. Open arrays and objects are kept on a stack
+// of element indices, so deeply nested documents can't overflow the native
+// stack.
+class DocumentParser {
+public:
+  explicit DocumentParser(JSONDocument& doc)
+      : m_doc{doc}, m_text{doc.m_text} {}
+
+  void parse() {
+    skip_whitespace();
+    bool opened{value()};
+    while (!m_stack.empty()) {
+      const size_t container{m_stack.back()};
+      const bool object{m_doc.m_elements[container].type == Type::object};
+      const char end{object ? '}' : ']'};
+
+      skip_whitespace();
+      if (peek() == end) {
+        m_pos++;
+        close();
+        opened = false;
+        continue;
+      }
+
+      if (!opened) {
+        if (peek() != ',') {
+          error(object ? "expecting ',' or '}'" : "expecting ',' or ']'");
+        }
+        m_pos++;
+        skip_whitespace();
+      }
+
+      auto& length{m_doc.m_elements[container].length};
+      if (length == max_length) {
+        error("too many items");
+      }
+      length++;
+
+      if (object) {
+        if (peek() != '"') {
+          error("expecting property name enclosed in double quotes");
+        }
+        string();
+        skip_whitespace();
+        if (peek() != ':') {
+          error("expecting ':' delimiter");
+        }
+        m_pos++;
+        skip_whitespace();
+      }
+
+      opened = value();
+    }
+
+    skip_whitespace();
+    if (m_pos != m_text.size()) {
+      error("extra data");
+    }
+  }
+
+private:
+  JSONDocument& m_doc;
+  std::string_view m_text;
+  size_t m_pos{0};
+  std::vector<size_t> m_stack{};
+
+  [[noreturn]] void error(const char* what) const {
+    throw JSONDecodeError(what, m_pos);
+  }
+
+  char peek() const { return m_pos < m_text.size() ? m_text[m_pos] : '\0'; }
+
+  void skip_whitespace() {
+    while (m_pos < m_text.size()) {
+      char c{m_text[m_pos]};
+      if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+        break;
+      }
+      m_pos++;
+    }
+  }
+
+  void push(Type type, bool flag, size_t length, size_t offset) {
+    if (length > max_length) {
+      error("value too long");
+    }
+    m_doc.m_elements.push_back(
+        {type, flag, static_cast<std::uint32_t>(length), offset});
+  }
+
+  // Parse a scalar value, or open an array or object. Return true if we
+  // opened an array or object.
+  bool value() {
+    switch (peek()) {
+      case '{':
+      case '[':
+        m_stack.push_back(m_doc.m_elements.size());
+        push(peek() == '{' ? Type::object : Type::array, false, 0, 0);
+        m_pos++;
+        return true;
+      case '"':
+        string();
+        return false;
+      case 't':
+        literal("true", Type::true_);
+        return false;
+      case 'f':
+        literal("false", Type::false_);
+        return false;
+      case 'n':
+        literal("null", Type::null);
+        return false;
+      case 'N':
+        literal("NaN", Type::real);
+        return false;
+      case 'I':
+        literal("Infinity", Type::real);
+        return false;
+      case '-':
+        if (m_text.substr(m_pos + 1, 8) == "Infinity") {
+          literal("-Infinity", Type::real);
+          return false;
+        }
+        number();
+        return false;
+      default:
+        if (is_digit(peek())) {
+          number();
+          return false;
+        }
+        error("expecting value");
+    }
+  }
+
+  void literal(std::string_view word, Type type) {
+    if (m_text.substr(m_pos, word.size()) != word) {
+      error("expecting value");
+    }
+    push(type, false, word.size(), m_pos);
+    m_pos += word.size();
+  }
+
+  void number() {
+    const size_t start{m_pos};
+    Type type{Type::integer};
+
+    if (peek() == '-') {
+      m_pos++;
+    }
+
+    if (peek() == '0') {
+      m_pos++;
+    } else if (is_digit(peek())) {
+      while (is_digit(peek())) {
+        m_pos++;
+      }
+    } else {
+      error("expecting value");
+    }
+
+    if (peek() == '.' && m_pos + 1 < m_text.size() &&
+        is_digit(m_text[m_pos + 1])) {
+      type = Type::real;
+      m_pos++;
+      while (is_digit(peek())) {
+        m_pos++;
+      }
+    }
+
+    if (peek() == 'e' || peek() == 'E') {
+      size_t exponent{m_pos + 1};
+      if (exponent < m_text.size() &&
+          (m_text[exponent] == '+' || m_text[exponent] == '-')) {
+        exponent++;
+      }
+      if (exponent < m_text.size() && is_digit(m_text[exponent])) {
+        type = Type::real;
+        m_pos = exponent;
+        while (is_digit(peek())) {
+          m_pos++;
+        }
+      }
+    }
+
+    push(type, false, m_pos - start, start);
+  }
+
+  // Read four hex digits after `\u`.
+  char32_t hex4() {
+    if (m_text.size() - m_pos < 4) {
+      error("invalid \\uXXXX escape");
+    }
+    char32_t rv{0};
+    for (size_t i = 0; i < 4; i++) {
+      int digit{hex_value(m_text[m_pos + i])};
+      if (digit < 0) {
+        error("invalid \\uXXXX escape");
+      }
+      rv = (rv << 4) | static_cast<char32_t>(digit);
+    }
+    m_pos += 4;
+    return rv;
+  }
+
+  void string() {
+    const size_t start{++m_pos};
+
+    // Most strings don't have escape sequences, so they are left in place.
+    while (m_pos < m_text.size()) {
+      auto c{static_cast<unsigned char>(m_text[m_pos])};
+      if (c == '"') {
+        push(Type::string, false, m_pos - start, start);
+        m_pos++;
+        return;
+      }
+      if (c == '\\') {
+        break;
+      }
+      if (c < 0x20) {
+        error("invalid control character");
+      }
+      m_pos++;
+    }
+
+    std::string& out{m_doc.m_unescaped};
+    const size_t offset{out.size()};
+    out.append(m_text.data() + start, m_pos - start);
+
+    while (true) {
+      if (m_pos >= m_text.size()) {
+        m_pos = start - 1;
+        error("unterminated string");
+      }
+
+      auto c{static_cast<unsigned char>(m_text[m_pos])};
+      if (c == '"') {
+        break;
+      }
+      if (c < 0x20) {
+        error("invalid control character");
+      }
+      m_pos++;
+      if (c != '\\') {
+        out.push_back(static_cast<char>(c));
+        continue;
+      }
+
+      switch (peek()) {
+        case '"':
+        case '\\':
+        case '/':
+          out.push_back(m_text[m_pos++]);
+          break;
+        case 'b':
+          out.push_back('\b');
+          m_pos++;
+          break;
+        case 'f':
+          out.push_back('\f');
+          m_pos++;
+          break;
+        case 'n':
+          out.push_back('\n');
+          m_pos++;
+          break;
+        case 'r':
+          out.push_back('\r');
+          m_pos++;
+          break;
+        case 't':
+          out.push_back('\t');
+          m_pos++;
+          break;
+        case 'u': {
+          m_pos++;
+          char32_t code_point{hex4()};
+          // Combine surrogate pairs. Lone surrogates are kept, like
+          // json.loads does.
+          if (code_point >= 0xD800 && code_point <= 0xDBFF &&
+              m_text.substr(m_pos, 2) == "\\u") {
+            const size_t pos{m_pos};
+            m_pos += 2;
+            char32_t low{hex4()};
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+              code_point =
+                  0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+            } else {
+              m_pos = pos;
+            }
+          }
+          append_utf8(out, code_point);
+          break;
+        }
+        default:
+          error("invalid \\escape");
+      }
+    }
+
+    push(Type::string, true, out.size() - offset, offset);
+    m_pos++;
+  }
+
+  // Finish the array or object at the top of the stack.
+  void close() {
+    const size_t index{m_stack.back()};
+    m_stack.pop_back();
+    auto& element{m_doc.m_elements[index]};
+    element.offset = m_doc.m_elements.size();
+    if (element.type == Type::object && element.length > 1) {
+      element.flag = duplicate_keys(index);
+    }
+  }
+
+  // Return true if a key appears more than once in the object at _index_.
+  bool duplicate_keys(size_t index) const {
+    const size_t end{m_doc.m_elements[index].offset};
+    std::vector<std::string_view> keys{};
+    keys.reserve(m_doc.m_elements[index].length);
+    for (size_t key = index + 1; key < end; key = m_doc.next(key + 1)) {
+      keys.push_back(m_doc.string(key));
+    }
+
+    if (keys.size() <= 8) {
+      for (size_t i = 0; i < keys.size(); i++) {
+        for (size_t j = i + 1; j < keys.size(); j++) {
+          if (keys[i] == keys[j]) {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    std::unordered_set<std::string_view> seen{};
+    for (const auto& key : keys) {
+      if (!seen.insert(key).second) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+JSONDocument::JSONDocument(std::string text) : m_text{std::move(text)} {
+  DocumentParser{*this}.parse();
+}
+
+JSONDocument JSONDocument::from_python(nb::handle data) {
+  if (PyUnicode_Check(data.ptr())) {
+    Py_ssize_t size{0};
+    const char* text{PyUnicode_AsUTF8AndSize(data.ptr(), &size)};
+    if (text) {
+      return JSONDocument{std::string{text, static_cast<size_t>(size)}};
+    }
+
+    // Strings with lone surrogates can't be encoded as UTF-8.
+    PyErr_Clear();
+    auto bytes{nb::steal<nb::bytes>(
+        PyUnicode_AsEncodedString(data.ptr(), "utf-8", "surrogatepass"))};
+    if (!bytes.is_valid()) {
+      throw nb::python_error();
+    }
+    return JSONDocument{std::string{bytes.c_str(), bytes.size()}};
+  }
+
+  Py_buffer view;
+  if (PyObject_GetBuffer(data.ptr(), &view, PyBUF_SIMPLE) != 0) {
+    PyErr_Clear();
+    throw nb::type_error(
+        "expected a str or bytes-like object containing JSON");
+  }
+  std::string text{static_cast<const char*>(view.buf),
+                   static_cast<size_t>(view.len)};
+  PyBuffer_Release(&view);
+
+  // Like json.loads, skip a UTF-8 byte order mark at the start of bytes.
+  if (text.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+    text.erase(0, 3);
+  }
+  return from_utf8(std::move(text));
+}
+
+JSONDocument JSONDocument::from_utf8(std::string text) {
+  const size_t invalid{invalid_utf8(text)};
+  if (invalid != text.size()) {
+    throw JSONDecodeError("invalid UTF-8", invalid);
+  }
+  return JSONDocument{std::move(text)};
+}
+
+nb::str JSONDocument::to_str(size_t index) const {
+  std::string_view text{string(index)};
+  PyObject* str{PyUnicode_DecodeUTF8(
+      text.data(), static_cast<Py_ssize_t>(text.size()), "surrogatepass")};
+  if (!str) {
+    throw nb::python_error();
+  }
+  return nb::steal<nb::str>(str);
+}
+
+namespace {
+
+nb::object integer_to_python(std::string_view text) {
+  // Up to 18 digits always fit in a 64-bit integer.
+  const bool negative{text[0] == '-'};
+  if (text.size() - negative <= 18) {
+    std::int64_t rv{0};
+    for (size_t i = negative; i < text.size(); i++) {
+      rv = rv * 10 + (text[i] - '0');
+    }
+    return nb::steal(PyLong_FromLongLong(negative ? -rv : rv));
+  }
+
+  std::string digits{text};
+  PyObject* rv{PyLong_FromString(digits.c_str(), nullptr, 10)};
+  if (!rv) {
+    throw nb::python_error();
+  }
+  return nb::steal(rv);
+}
+
+nb::object real_to_python(std::string_view text) {
+  // PyOS_string_to_double reads NaN and Infinity too, and overflows to
+  // infinity like float() does.
+  std::string digits{text};
+  double rv{PyOS_string_to_double(digits.c_str(), nullptr, nullptr)};
+  if (rv == -1.0 && PyErr_Occurred()) {
+    throw nb::python_error();
+  }
+  return nb::steal(PyFloat_FromDouble(rv));
+}
+
+}  // namespace
+
+nb::object JSONDocument::to_python(
+    size_t index,
+    const std::unordered_map<size_t, nb::object>* converted) const {
+  auto scalar{[this](size_t index_) -> nb::object {
+    switch (type(index_)) {
+      case Type::null:
+        return nb::none();
+      case Type::false_:
+        return nb::bool_(false);
+      case Type::true_:
+        return nb::bool_(true);
+      case Type::integer:
+        return integer_to_python(number(index_));
+      case Type::real:
+        return real_to_python(number(index_));
+      case Type::string:
+        return to_str(index_);
+      default:
+        break;
+    }
+
+    const Element& element_{m_elements[index_]};
+    PyObject* container{element_.type == Type::array
+                            ? PyList_New(element_.length)
+                            : PyDict_New()};
+    if (!container) {
+      throw nb::python_error();
+    }
+    return nb::steal(container);
+  }};
+
+  nb::object rv{scalar(index)};
+  if (type(index) != Type::array && type(index) != Type::object) {
+    return rv;
+  }
+
+  // Arrays and objects being filled, and the position of their next item or
+  // member.
+  struct Frame {
+    PyObject* container;
+    bool object;
+    size_t position;
+    size_t end;
+    Py_ssize_t item;
+  };
+
+  std::vector<Frame> stack{};
+  stack.push_back({rv.ptr(), type(index) == Type::object, index + 1,
+                   m_elements[index].offset, 0});
+
+  while (!stack.empty()) {
+    Frame& frame{stack.back()};
+    if (frame.position == frame.end) {
+      stack.pop_back();
+      continue;
+    }
+
+    size_t key{frame.position};
+    if (frame.object) {
+      frame.position++;
+    }
+    const size_t value_index{frame.position};
+    frame.position = next(value_index);
+
+    bool reused{false};
+    nb::object value{};
+    if (converted) {
+      auto it{converted->find(value_index)};
+      if (it != converted->end()) {
+        value = it->second;
+        reused = true;
+      }
+    }
+    if (!reused) {
+      value = scalar(value_index);
+    }
+
+    PyObject* container{frame.container};
+    if (frame.object) {
+      // Later values for repeated keys replace earlier ones.
+      if (PyDict_SetItem(container, to_str(key).ptr(), value.ptr()) != 0) {
+        throw nb::python_error();
+      }
+    } else {
+      // PyList_SetItem steals a reference.
+      PyList_SetItem(container, frame.item++, value.inc_ref().ptr());
+    }
+
+    const Type value_type{type(value_index)};
+    if (!reused &&
+        (value_type == Type::array || value_type == Type::object)) {
+      // Containers are kept alive by their parents.
+      stack.push_back({value.ptr(), value_type == Type::object,
+                       value_index + 1, m_elements[value_index].offset, 0});
+    }
+  }
+
+  return rv;
+}
+
+}  // namespace libjsonpath
@@ -0,0 +1,1604 @@
+#include "libjsonpath/document_query.hpp"
+
+#include <algorithm>      // std::all_of std::any_of std::max std::min std::sort
+#include <atomic>         // std::atomic
+#include <charconv>       // std::from_chars
+#include <cerrno>         // errno ERANGE
+#include <cstdint>        // std::int64_t std::uint8_t
+#include <cstdlib>        // std::strtod
+#include <exception>      // std::exception_ptr std::rethrow_exception
+#include <functional>     // std::function std::greater
+#include <limits>         // std::numeric_limits
+#include <memory>         // std::make_shared std::make_unique std::unique_ptr
+#include <optional>       // std::optional
+#include <string>         // std::string std::to_string
+#include <unordered_map>  // std::unordered_map
+#include <utility>        // std::exchange std::move std::pair
+#include <variant>        // std::get_if std::holds_alternative std::visit
+#include <vector>         // std::vector
+
+#include "libjsonpath/kernels.hpp"
+#include "libjsonpath/ndjson.hpp"
+#include "libjsonpath/serialize.hpp"
+#include "libjsonpath/typed_array.hpp"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+// A node in a JSONDocument: the index of its element, and of the location
+// step that led to it.
+struct DocumentNode {
+  size_t element;
+  size_t step;
+};
+
+// One step in a document node's location. _key_ is the index of an object
+// member's key element, or an array index.
+struct DocumentStep {
+  size_t parent;
+  size_t key;
+  bool is_index;
+};
+
+// Convert _obj_, a literal from a filter program, or return nothing if it
+// isn't a JSON scalar we can compare natively.
+std::optional<DocumentFilters::Literal> document_literal(nb::handle obj,
+                                                         nb::handle nothing) {
+  using Type = JSONDocument::Type;
+  DocumentFilters::Literal rv{Type::null, 0, 0.0, {}, false};
+  PyObject* ptr{obj.ptr()};
+  if (ptr == Py_None) {
+    rv.type = Type::null;
+  } else if (PyBool_Check(ptr)) {
+    rv.type = ptr == Py_True ? Type::true_ : Type::false_;
+  } else if (PyLong_CheckExact(ptr)) {
+    int overflow{0};
+    rv.type = Type::integer;
+    rv.integer = PyLong_AsLongLongAndOverflow(ptr, &overflow);
+    if (overflow) {
+      return std::nullopt;
+    }
+  } else if (PyFloat_CheckExact(ptr)) {
+    rv.type = Type::real;
+    rv.real = PyFloat_AsDouble(ptr);
+  } else if (PyUnicode_CheckExact(ptr)) {
+    // Encoded like strings in a JSONDocument, lone surrogates and all.
+    auto bytes{nb::steal<nb::bytes>(
+        PyUnicode_AsEncodedString(ptr, "utf-8", "surrogatepass"))};
+    if (!bytes.is_valid()) {
+      throw nb::python_error();
+    }
+    rv.type = Type::string;
+    rv.string = std::string{bytes.c_str(), bytes.size()};
+  } else {
+    return std::nullopt;
+  }
+
+  rv.nothing = equal_objects(nb::borrow(obj), nb::borrow(nothing));
+  return rv;
+}
+
+DocumentFilters::DocumentFilters(const segments_t& segments,
+                                 const FilterPrograms& filters,
+                                 nb::handle nothing) {
+  // Programs that don't call functions and only have scalar literals.
+  std::unordered_map<const FilterSelector*, Program> candidates{};
+  for_each_query(segments, [&](const segments_t& query) {
+    for (const auto& segment : query) {
+      for (const auto& selector : segment_selectors(segment)) {
+        auto filter{std::get_if<Box<FilterSelector>>(&selector)};
+        if (!filter) {
+          continue;
+        }
+
+        const FilterProgram& program{filters.get(**filter)};
+        Program native{program, {}};
+        bool ok{true};
+        for (const auto& instruction : program.code) {
+          ok = ok && instruction.opcode != Opcode::call;
+        }
+        for (const auto& literal : program.literals) {
+          auto converted{ok ? document_literal(literal, nothing)
+                            : std::nullopt};
+          ok = ok && converted;
+          if (ok) {
+            native.literals.push_back(std::move(*converted));
+          }
+        }
+        if (ok) {
+          candidates.emplace(&(**filter), std::move(native));
+        }
+      }
+    }
+  });
+
+  // Filters in a program's queries need to be native too.
+  std::function<bool(const segments_t&)> nested{};
+  nested = [&](const segments_t& query) {
+    for (const auto& segment : query) {
+      for (const auto& selector : segment_selectors(segment)) {
+        if (auto filter = std::get_if<Box<FilterSelector>>(&selector)) {
+          auto it{candidates.find(&(**filter))};
+          if (it == candidates.end()) {
+            return false;
+          }
+          for (const auto& query_ : it->second.program.queries) {
+            if (!nested(*query_.segments)) {
+              return false;
+            }
+          }
+        }
+      }
+    }
+    return true;
+  };
+
+  for (auto& [selector, program] : candidates) {
+    bool ok{true};
+    for (const auto& query : program.program.queries) {
+      ok = ok && nested(*query.segments);
+    }
+    if (ok) {
+      m_programs.emplace(selector, std::move(program));
+    }
+  }
+}
+
+bool DocumentFilters::native(const segments_t::value_type& segment) const {
+  for (const auto& selector : segment_selectors(segment)) {
+    if (auto filter = std::get_if<Box<FilterSelector>>(&selector)) {
+      if (!get(**filter)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Parse the text of an integer in a JSONDocument. Return nothing if it
+// doesn't fit in 64 bits.
+static std::optional<std::int64_t> parse_integer(std::string_view text) {
+  std::int64_t rv{0};
+  auto result{std::from_chars(text.data(), text.data() + text.size(), rv)};
+  if (result.ec != std::errc{}) {
+    return std::nullopt;
+  }
+  return rv;
+}
+
+// Parse the text of a real number in a JSONDocument, including NaN and
+// Infinity. Return nothing on overflow or underflow, which are left to
+// Python.
+//
+// This is called without the GIL, so it can't use PyOS_string_to_double,
+// and floating point std::from_chars isn't available on every platform we
+// build for. std::strtod is correctly rounded everywhere we build, but
+// follows LC_NUMERIC, so if a locale with another decimal point is set,
+// numbers it doesn't read to the end are left to Python too.
+static std::optional<double> parse_real(std::string_view text) {
+  if (text == "NaN") {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (text == "Infinity" || text == "-Infinity") {
+    double inf{std::numeric_limits<double>::infinity()};
+    return text[0] == '-' ? -inf : inf;
+  }
+
+  // std::strtod needs a terminated string.
+  char buf[64];
+  std::string long_text{};
+  const char* begin{buf};
+  if (text.size() < sizeof(buf)) {
+    text.copy(buf, text.size());
+    buf[text.size()] = '\0';
+  } else {
+    long_text = text;
+    begin = long_text.c_str();
+  }
+
+  char* end{nullptr};
+  errno = 0;
+  double rv{std::strtod(begin, &end)};
+  if (errno == ERANGE || end != begin + text.size()) {
+    return std::nullopt;
+  }
+  return rv;
+}
+
+// Like compare_list, for the elements _items_ of an array in _doc_.
+static std::optional<bitmap_t> compare_array(
+    const JSONDocument& doc, const std::vector<size_t>& items,
+    const LiteralComparison& comparison) {
+  ComparisonColumn column{};
+  for (auto item : items) {
+    bool pushed{false};
+    switch (doc.type(item)) {
+      case JSONDocument::Type::integer: {
+        auto value{parse_integer(doc.number(item))};
+        pushed = value && column.push_integer(*value);
+        break;
+      }
+      case JSONDocument::Type::real: {
+        auto value{parse_real(doc.number(item))};
+        pushed = value && column.push_real(*value);
+        break;
+      }
+      case JSONDocument::Type::string:
+        pushed = column.push_string(doc.string(item));
+        break;
+      default:
+        break;
+    }
+
+    if (!pushed) {
+      return std::nullopt;
+    }
+  }
+  return column.compare(comparison.op, comparison.literal);
+}
+
+// Append the element _element_ of _doc_ to _array_. Numbers that fit in a C
+// type are read from the document's text, and other numbers are converted
+// to Python objects first.
+static void push_element(TypedArray& array, const JSONDocument& doc,
+                         size_t element) {
+  switch (doc.type(element)) {
+    case JSONDocument::Type::integer:
+      if (auto value = parse_integer(doc.number(element))) {
+        array.push_integer(*value);
+        return;
+      }
+      break;
+    case JSONDocument::Type::real:
+      if (auto value = parse_real(doc.number(element))) {
+        array.push_real(*value);
+        return;
+      }
+      break;
+    default:
+      array.mismatch();
+      return;
+  }
+  array.push(doc.to_python(element));
+}
+
+// Write the element _element_ of _doc_, and its descendants, with _writer_.
+// Numbers are converted to Python objects only if they don't fit in a C
+// type, so they are written exactly like the values findall would return.
+static void write_element(JSONWriter& writer, const JSONDocument& doc,
+                          size_t element) {
+  switch (doc.type(element)) {
+    case JSONDocument::Type::null:
+      writer.write_raw("null");
+      break;
+    case JSONDocument::Type::false_:
+      writer.write_raw("false");
+      break;
+    case JSONDocument::Type::true_:
+      writer.write_raw("true");
+      break;
+    case JSONDocument::Type::integer:
+      if (auto value = parse_integer(doc.number(element))) {
+        writer.write_integer(*value);
+      } else {
+        writer.write(doc.to_python(element));
+      }
+      break;
+    case JSONDocument::Type::real:
+      if (auto value = parse_real(doc.number(element))) {
+        writer.write_real(*value);
+      } else {
+        writer.write(doc.to_python(element));
+      }
+      break;
+    case JSONDocument::Type::string:
+      writer.write_string(doc.string(element));
+      break;
+    case JSONDocument::Type::array:
+    case JSONDocument::Type::object: {
+      RecursionGuard recursion{};
+      bool is_array{doc.type(element) == JSONDocument::Type::array};
+      writer.write_raw(is_array ? "[" : "{");
+      bool first{true};
+      doc.for_each_child(element, [&](size_t key, size_t child, bool) {
+        if (!first) {
+          writer.write_raw(",");
+        }
+        first = false;
+        if (!is_array) {
+          writer.write_string(doc.string(key));
+          writer.write_raw(":");
+        }
+        write_element(writer, doc, child);
+      });
+      writer.write_raw(is_array ? "]" : "}");
+      break;
+    }
+  }
+}
+
+// Runs a DocumentFilters program against candidate elements, with the same
+// results as test_filter would give for the same candidates converted to
+// Python objects. Machines have their own scratch space, so every thread
+// needs its own.
+class DocumentFilterMachine {
+private:
+  using Type = JSONDocument::Type;
+  using Literal = DocumentFilters::Literal;
+
+  // A value on the stack. Elements selected by root queries come from a
+  // separately converted root, so they are never identical to elements
+  // selected by relative queries.
+  struct Operand {
+    enum class Kind : std::uint8_t { literal, boolean, element, nodes };
+    Kind kind;
+    bool root;
+    // A literal's index, a boolean, or an element's index.
+    size_t index;
+    std::vector<size_t> nodes;
+  };
+
+  // A literal, boolean or element, ready to compare.
+  struct Scalar {
+    Type type;
+    const Literal* literal;
+    bool is_element;
+    size_t element;
+    bool root;
+  };
+
+  enum class Order : std::uint8_t { less, equal, greater, unordered };
+
+  // Doubles represent every integer with a magnitude up to 2**53 exactly.
+  static constexpr std::int64_t max_exact_integer = std::int64_t{1} << 53;
+
+  struct Number {
+    bool real;
+    std::int64_t integer;
+    double value;
+  };
+
+  const DocumentFilters& m_filters;
+  const JSONDocument& m_doc;
+  const DocumentFilters::Program& m_program;
+  std::vector<Operand> m_stack{};
+  size_t m_size{0};
+
+  // Root query results, by query index, and machines for nested filters.
+  std::unordered_map<size_t, std::vector<size_t>> m_root_queries{};
+  std::unordered_map<const FilterSelector*,
+                     std::unique_ptr<DocumentFilterMachine>>
+      m_nested{};
+  std::vector<size_t> m_scratch{};
+
+public:
+  DocumentFilterMachine(const DocumentFilters& filters,
+                        const JSONDocument& doc,
+                        const DocumentFilters::Program& program)
+      : m_filters{filters}, m_doc{doc}, m_program{program} {
+    m_stack.resize(program.program.stack_size);
+  }
+
+  // Return true if the filter selects _candidate_, or nothing if only Python
+  // can tell.
+  std::optional<bool> test(size_t candidate) {
+    m_size = 0;
+    const auto& code{m_program.program.code};
+    for (size_t ip = 0; ip < code.size(); ip++) {
+      const auto& instruction{code[ip]};
+      switch (instruction.opcode) {
+        case Opcode::push:
+          push(Operand::Kind::literal, instruction.operand);
+          break;
+        case Opcode::relative_query: {
+          Operand& top{push(Operand::Kind::nodes, 0)};
+          if (!query(m_program.program.queries[instruction.operand],
+                     candidate, top.nodes)) {
+            return std::nullopt;
+          }
+          break;
+        }
+        case Opcode::root_query: {
+          auto it{m_root_queries.find(instruction.operand)};
+          if (it == m_root_queries.end()) {
+            std::vector<size_t> nodes{};
+            if (!query(m_program.program.queries[instruction.operand],
+                       JSONDocument::root, nodes)) {
+              return std::nullopt;
+            }
+            it = m_root_queries.emplace(instruction.operand, std::move(nodes))
+                     .first;
+          }
+          Operand& top{push(Operand::Kind::nodes, 0)};
+          top.nodes = it->second;
+          top.root = true;
+          break;
+        }
+        case Opcode::call:
+          // Programs with calls are never native.
+          return std::nullopt;
+        case Opcode::unpack: {
+          Operand& top{back()};
+          if (top.kind == Operand::Kind::nodes && top.nodes.size() == 1) {
+            top.kind = Operand::Kind::element;
+            top.index = top.nodes[0];
+          }
+          break;
+        }
+        case Opcode::truthy:
+          set_boolean(back(), truthy(back()));
+          break;
+        case Opcode::logical_not:
+          set_boolean(back(), !truthy(back()));
+          break;
+        case Opcode::jump_if_false:
+        case Opcode::jump_if_true: {
+          bool when{instruction.opcode == Opcode::jump_if_true};
+          if (truthy(back()) == when) {
+            set_boolean(back(), when);
+            ip += instruction.operand;
+          } else {
+            m_size--;
+          }
+          break;
+        }
+        case Opcode::compare: {
+          auto op{static_cast<BinaryOperator>(instruction.operand)};
+          auto rv{compare(m_stack[m_size - 2], op, m_stack[m_size - 1])};
+          if (!rv) {
+            return std::nullopt;
+          }
+          m_size--;
+          set_boolean(back(), *rv);
+          break;
+        }
+      }
+    }
+    return truthy(back());
+  }
+
+private:
+  Operand& push(Operand::Kind kind, size_t index) {
+    if (m_size == m_stack.size()) {
+      m_stack.emplace_back();
+    }
+    Operand& rv{m_stack[m_size++]};
+    rv.kind = kind;
+    rv.root = false;
+    rv.index = index;
+    rv.nodes.clear();
+    return rv;
+  }
+
+  Operand& back() { return m_stack[m_size - 1]; }
+
+  static void set_boolean(Operand& operand, bool value) {
+    operand.kind = Operand::Kind::boolean;
+    operand.index = value;
+  }
+
+  // Everything but false is truthy. Node lists are truthy if they are not
+  // empty.
+  bool truthy(const Operand& operand) const {
+    switch (operand.kind) {
+      case Operand::Kind::nodes:
+        return !operand.nodes.empty();
+      case Operand::Kind::boolean:
+        return operand.index;
+      default:
+        return scalar(operand).type != Type::false_;
+    }
+  }
+
+  Scalar scalar(const Operand& operand) const {
+    switch (operand.kind) {
+      case Operand::Kind::literal: {
+        const Literal& literal{m_program.literals[operand.index]};
+        return {literal.type, &literal, false, 0, false};
+      }
+      case Operand::Kind::boolean:
+        return {operand.index ? Type::true_ : Type::false_, nullptr, false, 0,
+                false};
+      default:
+        return element(operand.index, operand.root);
+    }
+  }
+
+  Scalar element(size_t index, bool root) const {
+    return {m_doc.type(index), nullptr, true, index, root};
+  }
+
+  // Apply _query_ to _start_, stopping after _query.limit_ nodes if it isn't
+  // zero. Returns false if a nested filter can't be decided natively.
+  bool query(const FilterQuery& query, size_t start,
+             std::vector<size_t>& out) {
+    const segments_t& segments{*query.segments};
+    out.clear();
+    out.push_back(start);
+    std::vector<size_t> nodes{};
+    for (size_t i = 0; i < segments.size(); i++) {
+      nodes.swap(out);
+      out.clear();
+      size_t limit{i + 1 == segments.size() ? query.limit : 0};
+      const auto& selectors{segment_selectors(segments[i])};
+      bool recursive{std::holds_alternative<RecursiveSegment>(segments[i])};
+      for (auto node : nodes) {
+        if (recursive ? !descend(node, selectors, out, limit)
+                      : !select(node, selectors, out, limit)) {
+          return false;
+        }
+        if (limit && out.size() >= limit) {
+          break;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool descend(size_t node, const selector_list_t& selectors,
+               std::vector<size_t>& out, size_t limit) {
+    std::vector<size_t> stack{node};
+    std::vector<size_t> children{};
+    while (!stack.empty()) {
+      size_t current{stack.back()};
+      stack.pop_back();
+      if (!select(current, selectors, out, limit)) {
+        return false;
+      }
+      if (limit && out.size() >= limit) {
+        return true;
+      }
+
+      children.clear();
+      m_doc.for_each_child(current, [&](size_t, size_t element, bool) {
+        children.push_back(element);
+      });
+      stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    return true;
+  }
+
+  bool select(size_t node, const selector_list_t& selectors,
+              std::vector<size_t>& out, size_t limit) {
+    for (const auto& selector : selectors) {
+      bool ok{std::visit(
+          [&](const auto& selector_) { return select(node, selector_, out); },
+          selector)};
+      if (!ok) {
+        return false;
+      }
+      if (limit && out.size() >= limit) {
+        out.resize(limit);
+        break;
+      }
+    }
+    return true;
+  }
+
+  bool select(size_t node, const NameSelector& selector,
+              std::vector<size_t>& out) {
+    const auto& element{m_doc.element(node)};
+    if (element.type != Type::object) {
+      return true;
+    }
+
+    // Without repeated keys, the first match is the only match.
+    size_t found{0};
+    for (size_t key = node + 1; key < element.offset;
+         key = m_doc.next(key + 1)) {
+      if (m_doc.string(key) == selector.name) {
+        found = key;
+        if (!element.flag) {
+          break;
+        }
+      }
+    }
+    if (found) {
+      out.push_back(found + 1);
+    }
+    return true;
+  }
+
+  bool select(size_t node, const IndexSelector& selector,
+              std::vector<size_t>& out) {
+    const auto& element{m_doc.element(node)};
+    if (element.type != Type::array) {
+      return true;
+    }
+
+    auto index{
+        normalized_index(element.length, selector.index, selector.token)};
+    if (index < element.length) {
+      size_t item{node + 1};
+      for (size_t i = 0; i < index; i++) {
+        item = m_doc.next(item);
+      }
+      out.push_back(item);
+    }
+    return true;
+  }
+
+  bool select(size_t node, const WildSelector&, std::vector<size_t>& out) {
+    m_doc.for_each_child(
+        node, [&](size_t, size_t element, bool) { out.push_back(element); });
+    return true;
+  }
+
+  bool select(size_t node, const SliceSelector& selector,
+              std::vector<size_t>& out) {
+    const auto& element{m_doc.element(node)};
+    if (element.type != Type::array) {
+      return true;
+    }
+
+    m_scratch.clear();
+    for (size_t item = node + 1; item < element.offset;
+         item = m_doc.next(item)) {
+      m_scratch.push_back(item);
+    }
+
+    auto slice{slice_bounds(selector, m_scratch.size())};
+    for (auto i{slice.start}; slice.in_range(i); i += slice.step) {
+      out.push_back(m_scratch[static_cast<size_t>(i)]);
+    }
+    return true;
+  }
+
+  bool select(size_t node, const Box<FilterSelector>& selector,
+              std::vector<size_t>& out) {
+    auto& machine{m_nested[&(*selector)]};
+    if (!machine) {
+      const auto* program{m_filters.get(*selector)};
+      if (!program) {
+        return false;
+      }
+      machine = std::make_unique<DocumentFilterMachine>(m_filters, m_doc,
+                                                        *program);
+    }
+
+    bool ok{true};
+    m_doc.for_each_child(node, [&](size_t, size_t element, bool) {
+      if (!ok) {
+        return;
+      }
+      auto rv{machine->test(element)};
+      if (!rv) {
+        ok = false;
+      } else if (*rv) {
+        out.push_back(element);
+      }
+    });
+    return ok;
+  }
+
+  std::optional<bool> compare(const Operand& left, BinaryOperator op,
+                              const Operand& right) const {
+    bool objects{left.kind != Operand::Kind::nodes &&
+                 right.kind != Operand::Kind::nodes};
+    switch (op) {
+      case BinaryOperator::eq:
+        return equals(left, right);
+      case BinaryOperator::ne: {
+        auto rv{equals(left, right)};
+        return rv ? std::optional<bool>{!*rv} : std::nullopt;
+      }
+      case BinaryOperator::lt:
+        return objects ? less(scalar(left), scalar(right)) : false;
+      case BinaryOperator::gt:
+        return objects ? less(scalar(right), scalar(left)) : false;
+      case BinaryOperator::le:
+      case BinaryOperator::ge: {
+        if (!objects) {
+          return equals(left, right);
+        }
+        auto rv{op == BinaryOperator::le ? less(scalar(left), scalar(right))
+                                         : less(scalar(right), scalar(left))};
+        if (!rv || *rv) {
+          return rv;
+        }
+        return equal(scalar(left), scalar(right));
+      }
+      default:
+        return false;
+    }
+  }
+
+  std::optional<bool> equals(const Operand& left,
+                             const Operand& right) const {
+    if (left.kind == Operand::Kind::nodes) {
+      return node_list_equals(left, right);
+    }
+    if (right.kind == Operand::Kind::nodes) {
+      return node_list_equals(right, left);
+    }
+    return equal(scalar(left), scalar(right));
+  }
+
+  std::optional<bool> node_list_equals(const Operand& left,
+                                       const Operand& right) const {
+    if (right.kind != Operand::Kind::nodes) {
+      if (left.nodes.empty()) {
+        // Only literals know if they are equal to nothing.
+        if (right.kind == Operand::Kind::literal) {
+          return m_program.literals[right.index].nothing;
+        }
+        return std::nullopt;
+      }
+      if (left.nodes.size() == 1) {
+        return equal(element(left.nodes[0], left.root), scalar(right));
+      }
+      return false;
+    }
+
+    if (left.nodes.empty() && right.nodes.empty()) {
+      return true;
+    }
+    if (left.nodes.size() == 1 && right.nodes.size() == 1) {
+      return equal(element(left.nodes[0], left.root),
+                   element(right.nodes[0], right.root));
+    }
+    return false;
+  }
+
+  static bool is_numeric(Type type) {
+    return type == Type::false_ || type == Type::true_ ||
+           type == Type::integer || type == Type::real;
+  }
+
+  std::optional<Number> number(const Scalar& value) const {
+    switch (value.type) {
+      case Type::false_:
+      case Type::true_:
+        return Number{false, value.type == Type::true_, 0.0};
+      case Type::integer: {
+        if (value.literal) {
+          return Number{false, value.literal->integer, 0.0};
+        }
+        auto rv{parse_integer(m_doc.number(value.element))};
+        if (!rv) {
+          return std::nullopt;
+        }
+        return Number{false, *rv, 0.0};
+      }
+      case Type::real: {
+        if (value.literal) {
+          return Number{true, 0, value.literal->real};
+        }
+        auto rv{parse_real(m_doc.number(value.element))};
+        if (!rv) {
+          return std::nullopt;
+        }
+        return Number{true, 0, *rv};
+      }
+      default:
+        return std::nullopt;
+    }
+  }
+
+  // Like compare_numbers. Returns nothing if the numbers can't be compared
+  // exactly as C scalars.
+  std::optional<Order> order(const Scalar& left, const Scalar& right) const {
+    auto l{number(left)};
+    auto r{number(right)};
+    if (!l || !r) {
+      return std::nullopt;
+    }
+
+    if (!l->real && !r->real) {
+      return l->integer < r->integer   ? Order::less
+             : l->integer > r->integer ? Order::greater
+                                       : Order::equal;
+    }
+
+    for (auto* n : {&*l, &*r}) {
+      if (!n->real) {
+        if (n->integer > max_exact_integer || n->integer < -max_exact_integer) {
+          return std::nullopt;
+        }
+        n->value = static_cast<double>(n->integer);
+      }
+    }
+
+    if (l->value < r->value) {
+      return Order::less;
+    }
+    if (l->value > r->value) {
+      return Order::greater;
+    }
+    return l->value == r->value ? Order::equal : Order::unordered;
+  }
+
+  std::string_view string(const Scalar& value) const {
+    return value.literal ? std::string_view{value.literal->string}
+                         : m_doc.string(value.element);
+  }
+
+  // Like equal_objects.
+  std::optional<bool> equal(const Scalar& left, const Scalar& right) const {
+    if (left.is_element && right.is_element &&
+        left.element == right.element && left.root == right.root) {
+      // Identical objects are equal, even if they are NaN.
+      return true;
+    }
+
+    if (is_numeric(left.type) && is_numeric(right.type)) {
+      auto rv{order(left, right)};
+      return rv ? std::optional<bool>{*rv == Order::equal} : std::nullopt;
+    }
+
+    if (left.type != right.type) {
+      return false;
+    }
+
+    switch (left.type) {
+      case Type::null:
+        return true;
+      case Type::string:
+        return string(left) == string(right);
+      default:
+        // Arrays and objects are compared by Python.
+        return std::nullopt;
+    }
+  }
+
+  // Like less_than. Booleans and mixed types are never ordered.
+  std::optional<bool> less(const Scalar& left, const Scalar& right) const {
+    if (left.type == Type::string && right.type == Type::string) {
+      return string(left) < string(right);
+    }
+
+    bool left_number{left.type == Type::integer || left.type == Type::real};
+    bool right_number{right.type == Type::integer || right.type == Type::real};
+    if (left_number && right_number) {
+      auto rv{order(left, right)};
+      return rv ? std::optional<bool>{*rv == Order::less} : std::nullopt;
+    }
+    return false;
+  }
+};
+
+// Evaluates a query against a JSONDocument, segment by segment, with the
+// same semantics as resolve. Filters are evaluated natively where possible,
+// and otherwise by converting each candidate to a Python object, so filters
+// that call function extensions work unchanged.
+//
+// With a parallel threshold, a child segment with one wildcard, slice or
+// filter selector that is applied to an array with at least that many items
+// is split into chunks of items. Chunks are evaluated, along with the rest of
+// the query, on a pool of threads without the GIL, and their results are
+// joined in document order.
+class DocumentQuery {
+public:
+  DocumentQuery(const JSONDocument& doc, const QueryPlan& plan,
+                nb::handle nothing, DocumentParallel parallel = {0, nullptr})
+      : m_doc{doc}, m_plan{plan}, m_nothing{nothing}, m_parallel{parallel} {}
+
+  std::vector<DocumentNode> resolve(const segments_t& segments) {
+    m_native.assign(segments.size() + 1, true);
+    for (size_t i = segments.size(); i-- > 0;) {
+      m_native[i] =
+          m_native[i + 1] && m_plan.document_filters.native(segments[i]);
+    }
+    return resolve(segments, 0, {{JSONDocument::root, no_step}});
+  }
+
+  // Like resolve, but don't call into Python, so the GIL isn't needed.
+  // Returns nothing if a filter can't be evaluated without Python.
+  std::optional<std::vector<DocumentNode>> resolve_native(
+      const segments_t& segments) {
+    m_native_only = true;
+    try {
+      return resolve(segments, 0, {{JSONDocument::root, no_step}});
+    } catch (const NeedsPython&) {
+      return std::nullopt;
+    }
+  }
+
+  // Convert the elements of _nodes_ to Python objects. Innermost elements
+  // are converted first and reused by their ancestors, so nested results
+  // share objects, just like they would if the whole document had been
+  // decoded, and no element is converted twice.
+  void convert(const std::vector<DocumentNode>& nodes) {
+    std::vector<size_t> elements{};
+    elements.reserve(nodes.size());
+    for (const auto& node : nodes) {
+      elements.push_back(node.element);
+    }
+    std::sort(elements.begin(), elements.end(), std::greater<size_t>{});
+    for (auto element : elements) {
+      if (m_values.find(element) == m_values.end()) {
+        m_values.emplace(element, m_doc.to_python(element, &m_values));
+      }
+    }
+  }
+
+  // The Python object for _node_, after converting it with convert.
+  const nb::object& value(const DocumentNode& node) const {
+    return m_values.at(node.element);
+  }
+
+  JSONPathNode located(const DocumentNode& node) {
+    nb::object val{value(node)};
+    return {val, chain(node.step)};
+  }
+
+  // The normalized path of _node_, without converting its value.
+  std::string path(const DocumentNode& node) {
+    nb::object val{nb::none()};
+    return JSONPathNode{val, chain(node.step)}.path();
+  }
+
+private:
+  static constexpr size_t no_step = static_cast<size_t>(-1);
+
+  // Steps made by a chunk's query are numbered with this bit set, until they
+  // are moved to the query that started the chunk.
+  static constexpr size_t local_step = ~(no_step >> 1);
+
+  // Smallest number of items in a chunk.
+  static constexpr size_t min_chunk_size = 256;
+
+  // Thrown when a filter can't be evaluated without Python, and we can't
+  // call into Python.
+  struct NeedsPython {};
+
+  const JSONDocument& m_doc;
+  const QueryPlan& m_plan;
+  nb::handle m_nothing;
+  DocumentParallel m_parallel;
+  bool m_native_only{false};
+  bool m_local{false};
+  std::vector<DocumentStep> m_steps{};
+
+  // m_native[i] is true if segments from _i_ onwards have native filters.
+  std::vector<bool> m_native{};
+
+  // Only created if a filter needs Python.
+  std::optional<QueryContext> m_context{};
+
+  // Candidates selected by filters, already converted to Python objects.
+  std::unordered_map<size_t, nb::object> m_values{};
+
+  // Location chains built so far, by step.
+  std::unordered_map<size_t, location_chain_t> m_chains{};
+
+  // Tags the constructor for a query of one chunk of a wide segment.
+  struct Worker {};
+
+  DocumentQuery(const DocumentQuery& parent, Worker)
+      : m_doc{parent.m_doc},
+        m_plan{parent.m_plan},
+        m_nothing{parent.m_nothing},
+        m_parallel{0, nullptr},
+        m_native_only{true},
+        m_local{true} {}
+
+  std::vector<DocumentNode> resolve(const segments_t& segments, size_t first,
+                                    std::vector<DocumentNode> nodes) {
+    std::vector<DocumentNode> out_nodes{};
+    for (size_t i = first; i < segments.size(); i++) {
+      if (std::any_of(nodes.begin(), nodes.end(), [&](const auto& node) {
+            return wide(segments, i, node);
+          })) {
+        // Nodes are resolved one at a time from here on, to keep results in
+        // order.
+        std::vector<DocumentNode> rv{};
+        for (const auto& node : nodes) {
+          auto part{wide(segments, i, node) ? parallel(segments, i, node)
+                                            : resolve(segments, i, {node})};
+          rv.insert(rv.end(), part.begin(), part.end());
+        }
+        return rv;
+      }
+
+      out_nodes.clear();
+      const auto& selectors{segment_selectors(segments[i])};
+      if (std::holds_alternative<RecursiveSegment>(segments[i])) {
+        for (const auto& node : nodes) {
+          descend(node, selectors, out_nodes);
+        }
+      } else {
+        for (const auto& node : nodes) {
+          select(node, selectors, out_nodes);
+        }
+      }
+      nodes.swap(out_nodes);
+    }
+    return nodes;
+  }
+
+  // Return true if segment _i_ should be applied to _node_ in parallel.
+  bool wide(const segments_t& segments, size_t i,
+            const DocumentNode& node) const {
+    if (!m_parallel.threshold || m_native_only || !m_native[i]) {
+      return false;
+    }
+
+    const auto* segment{std::get_if<Segment>(&segments[i])};
+    if (!segment || segment->selectors.size() != 1 ||
+        std::holds_alternative<NameSelector>(segment->selectors[0]) ||
+        std::holds_alternative<IndexSelector>(segment->selectors[0])) {
+      return false;
+    }
+
+    const auto& element{m_doc.element(node.element)};
+    return element.type == JSONDocument::Type::array &&
+           element.length >= m_parallel.threshold;
+  }
+
+  // Apply segment _i_ to _node_, an array, and the rest of _segments_ to the
+  // nodes it selects, in chunks on a pool of threads.
+  std::vector<DocumentNode> parallel(const segments_t& segments, size_t i,
+                                     const DocumentNode& node) {
+    const auto& selector{segment_selectors(segments[i])[0]};
+    const auto* filter{std::get_if<Box<FilterSelector>>(&selector)};
+
+    // Array indices and elements of the items the selector might select.
+    std::vector<std::pair<size_t, size_t>> items{};
+    const auto& element{m_doc.element(node.element)};
+    items.reserve(element.length);
+    for (size_t item = node.element + 1; item < element.offset;
+         item = m_doc.next(item)) {
+      items.emplace_back(items.size(), item);
+    }
+    if (filter) {
+      // Filters that compare each item with a literal are applied up front,
+      // leaving only the rest of the query for the chunks.
+      const auto& comparison{m_plan.filters.get(**filter).literal_comparison};
+      std::optional<bitmap_t> selected{};
+      if (comparison) {
+        std::vector<size_t> elements{};
+        elements.reserve(items.size());
+        for (const auto& item : items) {
+          elements.push_back(item.second);
+        }
+        selected = compare_array(m_doc, elements, *comparison);
+      }
+      if (selected) {
+        std::vector<std::pair<size_t, size_t>> filtered{};
+        for_each_selected(*selected,
+                          [&](size_t j) { filtered.push_back(items[j]); });
+        items.swap(filtered);
+        filter = nullptr;
+      }
+    }
+    if (const auto* slice = std::get_if<SliceSelector>(&selector)) {
+      auto bounds{slice_bounds(*slice, items.size())};
+      std::vector<std::pair<size_t, size_t>> sliced{};
+      for (auto j{bounds.start}; bounds.in_range(j); j += bounds.step) {
+        sliced.push_back(items[static_cast<size_t>(j)]);
+      }
+      items.swap(sliced);
+    }
+
+    size_t threads{m_parallel.pool->size()};
+    size_t chunk_size{std::max(min_chunk_size,
+                               (items.size() + threads * 8 - 1) / (threads * 8))};
+    size_t chunks{(items.size() + chunk_size - 1) / chunk_size};
+
+    // Chunks that need Python are left for later.
+    struct Part {
+      std::vector<DocumentNode> nodes{};
+      std::vector<DocumentStep> steps{};
+      bool python{false};
+    };
+    std::vector<Part> parts(chunks);
+
+    auto chunk_items{[&](size_t chunk) {
+      auto begin{items.begin() +
+                 static_cast<std::ptrdiff_t>(chunk * chunk_size)};
+      auto end{items.begin() + static_cast<std::ptrdiff_t>(std::min(
+                                   (chunk + 1) * chunk_size, items.size()))};
+      return std::make_pair(begin, end);
+    }};
+
+    {
+      nb::gil_scoped_release release{};
+      m_parallel.pool->parallel_for(chunks, [&](size_t chunk) {
+        DocumentQuery query{*this, Worker{}};
+        auto [begin, end] = chunk_items(chunk);
+        try {
+          std::vector<DocumentNode> nodes{};
+          std::optional<DocumentFilterMachine> machine{};
+          if (filter) {
+            machine.emplace(m_plan.document_filters, m_doc,
+                            *m_plan.document_filters.get(**filter));
+          }
+          for (auto it{begin}; it != end; it++) {
+            if (machine) {
+              auto selected{machine->test(it->second)};
+              if (!selected) {
+                throw NeedsPython{};
+              }
+              if (!*selected) {
+                continue;
+              }
+            }
+            nodes.push_back(query.child(node, it->second, it->first, true));
+          }
+          parts[chunk].nodes = query.resolve(segments, i + 1, std::move(nodes));
+          parts[chunk].steps = std::move(query.m_steps);
+        } catch (const NeedsPython&) {
+          parts[chunk] = Part{};
+          parts[chunk].python = true;
+        }
+      });
+    }
+
+    std::vector<DocumentNode> rv{};
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+      Part& part{parts[chunk]};
+      if (part.python) {
+        auto [begin, end] = chunk_items(chunk);
+        std::vector<DocumentNode> nodes{};
+        for (auto it{begin}; it != end; it++) {
+          if (!filter || test(**filter, it->second)) {
+            nodes.push_back(child(node, it->second, it->first, true));
+          }
+        }
+        auto resolved{resolve(segments, i + 1, std::move(nodes))};
+        rv.insert(rv.end(), resolved.begin(), resolved.end());
+        continue;
+      }
+
+      // Renumber the chunk's steps after ours.
+      size_t offset{m_steps.size()};
+      auto renumber{[offset](size_t step) {
+        return step != no_step && (step & local_step)
+                   ? (step & ~local_step) + offset
+                   : step;
+      }};
+      for (auto step : part.steps) {
+        step.parent = renumber(step.parent);
+        m_steps.push_back(step);
+      }
+      for (auto selected : part.nodes) {
+        selected.step = renumber(selected.step);
+        rv.push_back(selected);
+      }
+    }
+    return rv;
+  }
+
+  const QueryContext& context() {
+    if (!m_context) {
+      // Filters with root queries need the whole document as Python objects.
+      nb::object root{m_plan.filters.root_queries()
+                          ? m_doc.to_python(JSONDocument::root)
+                          : nb::none()};
+      m_context.emplace(root, nb::borrow(m_nothing), m_plan.filters,
+                        m_plan.names);
+    }
+    return *m_context;
+  }
+
+  DocumentNode child(const DocumentNode& parent, size_t element, size_t key,
+                     bool is_index) {
+    m_steps.push_back({parent.step, key, is_index});
+    size_t step{m_steps.size() - 1};
+    return {element, m_local ? step | local_step : step};
+  }
+
+  // Visit _node_ and its descendants in the same order as Descendants.
+  void descend(const DocumentNode& node, const selector_list_t& selectors,
+               std::vector<DocumentNode>& out_nodes) {
+    std::vector<DocumentNode> stack{node};
+    std::vector<DocumentNode> children{};
+    while (!stack.empty()) {
+      DocumentNode current{stack.back()};
+      stack.pop_back();
+      select(current, selectors, out_nodes);
+
+      children.clear();
+      m_doc.for_each_child(current.element,
+                           [&](size_t key, size_t element, bool is_index) {
+                             children.push_back(
+                                 child(current, element, key, is_index));
+                           });
+      stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+  }
+
+  void select(const DocumentNode& node, const selector_list_t& selectors,
+              std::vector<DocumentNode>& out_nodes) {
+    for (const auto& selector : selectors) {
+      std::visit([&](const auto& selector_) { select(node, selector_, out_nodes); },
+                 selector);
+    }
+  }
+
+  void select(const DocumentNode& node, const NameSelector& selector,
+              std::vector<DocumentNode>& out_nodes) {
+    const auto& element{m_doc.element(node.element)};
+    if (element.type != JSONDocument::Type::object) {
+      return;
+    }
+
+    // Without repeated keys, the first match is the only match.
+    size_t found{0};
+    for (size_t key = node.element + 1; key < element.offset;
+         key = m_doc.next(key + 1)) {
+      if (m_doc.string(key) == selector.name) {
+        found = key;
+        if (!element.flag) {
+          break;
+        }
+      }
+    }
+    if (found) {
+      out_nodes.push_back(child(node, found + 1, found, false));
+    }
+  }
+
+  void select(const DocumentNode& node, const IndexSelector& selector,
+              std::vector<DocumentNode>& out_nodes) {
+    const auto& element{m_doc.element(node.element)};
+    if (element.type != JSONDocument::Type::array) {
+      return;
+    }
+
+    auto index{
+        normalized_index(element.length, selector.index, selector.token)};
+    if (index < element.length) {
+      size_t item{node.element + 1};
+      for (size_t i = 0; i < index; i++) {
+        item = m_doc.next(item);
+      }
+      out_nodes.push_back(child(node, item, index, true));
+    }
+  }
+
+  void select(const DocumentNode& node, const WildSelector&,
+              std::vector<DocumentNode>& out_nodes) {
+    m_doc.for_each_child(node.element,
+                         [&](size_t key, size_t element, bool is_index) {
+                           out_nodes.push_back(
+                               child(node, element, key, is_index));
+                         });
+  }
+
+  void select(const DocumentNode& node, const SliceSelector& selector,
+              std::vector<DocumentNode>& out_nodes) {
+    const auto& element{m_doc.element(node.element)};
+    if (element.type != JSONDocument::Type::array) {
+      return;
+    }
+
+    std::vector<size_t> items{};
+    items.reserve(element.length);
+    for (size_t item = node.element + 1; item < element.offset;
+         item = m_doc.next(item)) {
+      items.push_back(item);
+    }
+
+    auto slice{slice_bounds(selector, items.size())};
+    for (auto i{slice.start}; slice.in_range(i); i += slice.step) {
+      out_nodes.push_back(
+          child(node, items[i], static_cast<size_t>(i), true));
+    }
+  }
+
+  void select(const DocumentNode& node, const Box<FilterSelector>& selector,
+              std::vector<DocumentNode>& out_nodes) {
+    const auto type{m_doc.type(node.element)};
+    if (type != JSONDocument::Type::array &&
+        type != JSONDocument::Type::object) {
+      return;
+    }
+
+    if (type == JSONDocument::Type::array && columnar(node, *selector,
+                                                     out_nodes)) {
+      return;
+    }
+
+    const auto* program{m_plan.document_filters.get(*selector)};
+    std::optional<DocumentFilterMachine> machine{};
+    if (program) {
+      machine.emplace(m_plan.document_filters, m_doc, *program);
+    }
+
+    m_doc.for_each_child(node.element,
+                         [&](size_t key, size_t element, bool is_index) {
+                           std::optional<bool> selected{};
+                           if (machine) {
+                             selected = machine->test(element);
+                           }
+                           if (selected ? *selected
+                                        : test(*selector, element)) {
+                             out_nodes.push_back(
+                                 child(node, element, key, is_index));
+                           }
+                         });
+  }
+
+  // Filter the array _node_ with a comparison kernel, if _selector_ compares
+  // each item with a literal. Return false if the array must be filtered one
+  // item at a time.
+  bool columnar(const DocumentNode& node, const FilterSelector& selector,
+                std::vector<DocumentNode>& out_nodes) {
+    const auto& comparison{m_plan.filters.get(selector).literal_comparison};
+    if (!comparison ||
+        m_doc.element(node.element).length < min_column_size) {
+      return false;
+    }
+
+    std::vector<size_t> items{};
+    items.reserve(m_doc.element(node.element).length);
+    for (size_t item = node.element + 1;
+         item < m_doc.element(node.element).offset; item = m_doc.next(item)) {
+      items.push_back(item);
+    }
+
+    auto selected{compare_array(m_doc, items, *comparison)};
+    if (!selected) {
+      return false;
+    }
+
+    for_each_selected(*selected, [&](size_t i) {
+      out_nodes.push_back(child(node, items[i], i, true));
+    });
+    return true;
+  }
+
+  // Test _element_ by converting it to a Python object and running the
+  // filter in Python.
+  bool test(const FilterSelector& selector, size_t element) {
+    if (m_native_only) {
+      throw NeedsPython{};
+    }
+    nb::object val{m_doc.to_python(element)};
+    if (!test_filter(context(), selector, val)) {
+      return false;
+    }
+    m_values.emplace(element, std::move(val));
+    return true;
+  }
+
+  // Build the location chain for _step_, reusing chains we've already built
+  // for its ancestors.
+  location_chain_t chain(size_t step) {
+    std::vector<size_t> missing{};
+    location_chain_t rv{};
+    while (step != no_step) {
+      auto it{m_chains.find(step)};
+      if (it != m_chains.end()) {
+        rv = it->second;
+        break;
+      }
+      missing.push_back(step);
+      step = m_steps[step].parent;
+    }
+
+    for (auto it{missing.rbegin()}; it != missing.rend(); it++) {
+      const DocumentStep& step_{m_steps[*it]};
+      size_t depth{rv ? rv->depth + 1 : 1};
+      rv = step_.is_index ? std::make_shared<LocationStep>(
+                                LocationStep{rv, step_.key, depth})
+                          : std::make_shared<LocationStep>(LocationStep{
+                                rv, m_doc.to_str(step_.key), depth});
+      m_chains.emplace(*it, rv);
+    }
+    return rv;
+  }
+};
+
+JSONPathNodeList query_document(const JSONDocument& doc, const QueryPlan& plan,
+                                nb::handle nothing, DocumentParallel parallel) {
+  DocumentQuery query{doc, plan, nothing, parallel};
+  auto nodes{query.resolve(plan.segments)};
+  query.convert(nodes);
+  JSONPathNodeList rv{};
+  rv.reserve(nodes.size());
+  for (const auto& node : nodes) {
+    rv.push_back(query.located(node));
+  }
+  return rv;
+}
+
+nb::list findall_document(const JSONDocument& doc, const QueryPlan& plan,
+                          nb::handle nothing, DocumentParallel parallel) {
+  DocumentQuery query{doc, plan, nothing, parallel};
+  auto nodes{query.resolve(plan.segments)};
+  query.convert(nodes);
+  nb::list rv{};
+  for (const auto& node : nodes) {
+    rv.append(query.value(node));
+  }
+  return rv;
+}
+
+nb::object findall_array_document(const JSONDocument& doc,
+                                  const QueryPlan& plan, nb::handle nothing,
+                                  DocumentParallel parallel,
+                                  std::string_view dtype, bool masked) {
+  TypedArray rv{dtype, masked};
+  DocumentQuery query{doc, plan, nothing, parallel};
+  auto nodes{query.resolve(plan.segments)};
+  rv.reserve(nodes.size());
+  for (const auto& node : nodes) {
+    push_element(rv, doc, node.element);
+  }
+  return rv.to_python();
+}
+
+nb::bytes findall_json_document(const JSONDocument& doc, const QueryPlan& plan,
+                                nb::handle nothing, DocumentParallel parallel) {
+  DocumentQuery query{doc, plan, nothing, parallel};
+  auto nodes{query.resolve(plan.segments)};
+  JSONWriter writer{};
+  writer.write_raw("[");
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (i) {
+      writer.write_raw(",");
+    }
+    write_element(writer, doc, nodes[i].element);
+  }
+  writer.write_raw("]");
+  return writer.to_bytes();
+}
+
+nb::bytes query_json_document(const JSONDocument& doc, const QueryPlan& plan,
+                              nb::handle nothing, DocumentParallel parallel) {
+  DocumentQuery query{doc, plan, nothing, parallel};
+  auto nodes{query.resolve(plan.segments)};
+  JSONWriter writer{};
+  writer.write_raw("[");
+  for (size_t i = 0; i < nodes.size(); i++) {
+    writer.write_raw(i ? ",{\"path\":" : "{\"path\":");
+    writer.write_string(query.path(nodes[i]));
+    writer.write_raw(",\"value\":");
+    write_element(writer, doc, nodes[i].element);
+    writer.write_raw("}");
+  }
+  writer.write_raw("]");
+  return writer.to_bytes();
+}
+
+struct NDJSONIterator::State {
+  // A parsed line and, if the query could be evaluated without Python, the
+  // nodes it selected.
+  struct Line {
+    std::unique_ptr<JSONDocument> doc;
+    std::unique_ptr<DocumentQuery> query{};
+    std::vector<DocumentNode> nodes{};
+  };
+
+  State(const std::string& path, std::shared_ptr<const QueryPlan> plan_,
+        nb::object nothing_, size_t threads, bool ordered, bool values_)
+      : file{path},
+        plan{std::move(plan_)},
+        nothing{nothing_},
+        native{std::all_of(
+            plan->segments.begin(), plan->segments.end(),
+            [this](const auto& segment) {
+              return plan->document_filters.native(segment);
+            })},
+        values{values_},
+        workers{file.text(),
+                [this](size_t line, std::string_view text) {
+                  return parse(line, text);
+                },
+                threads, ordered} {}
+
+  // Members used by worker threads come before _workers_, so they outlive
+  // the threads.
+  MappedFile file;
+  std::shared_ptr<const QueryPlan> plan;
+  nb::object nothing;
+  // True if the query's filters can be evaluated without Python.
+  bool native;
+  bool values;
+  LineWorkers<Line> workers;
+
+  // Lines from the chunk we're working through, and the exception that
+  // ended it, if any.
+  std::vector<std::pair<size_t, Line>> lines{};
+  size_t position{0};
+  std::exception_ptr error{};
+  bool done{false};
+  std::atomic<bool> running{false};
+
+  // Called by worker threads, without the GIL.
+  std::optional<Line> parse(size_t line, std::string_view text) const {
+    Line rv{};
+    try {
+      rv.doc = std::make_unique<JSONDocument>(
+          JSONDocument::from_utf8(std::string{text}));
+    } catch (const JSONDecodeError& err) {
+      throw JSONDecodeError("line " + std::to_string(line) + ": " + err.reason,
+                            err.position);
+    }
+
+    // Filters that call Python have to wait for the GIL.
+    if (native) {
+      auto query{std::make_unique<DocumentQuery>(*rv.doc, *plan, nothing)};
+      if (auto nodes{query->resolve_native(plan->segments)}) {
+        if (nodes->empty()) {
+          return std::nullopt;
+        }
+        rv.query = std::move(query);
+        rv.nodes = std::move(*nodes);
+      }
+    }
+    return rv;
+  }
+
+  NDJSONLine result(size_t line, DocumentQuery& query,
+                    const std::vector<DocumentNode>& nodes) const {
+    query.convert(nodes);
+    NDJSONLine rv{line, {}, {}};
+    if (values) {
+      for (const auto& node : nodes) {
+        rv.values.append(query.value(node));
+      }
+    } else {
+      rv.nodes.reserve(nodes.size());
+      for (const auto& node : nodes) {
+        rv.nodes.push_back(query.located(node));
+      }
+    }
+    return rv;
+  }
+};
+
+NDJSONIterator::NDJSONIterator(std::unique_ptr<State> state)
+    : m_state{std::move(state)} {}
+
+NDJSONIterator::NDJSONIterator(NDJSONIterator&&) noexcept = default;
+
+NDJSONIterator::~NDJSONIterator() = default;
+
+bool NDJSONIterator::values() const { return m_state->values; }
+
+std::optional<NDJSONLine> NDJSONIterator::next() {
+  State& state{*m_state};
+  Running running{state.running};
+  while (!state.done) {
+    if (state.position == state.lines.size()) {
+      state.lines.clear();
+      state.position = 0;
+
+      // Lines before a bad line are produced before its error is raised.
+      if (state.error) {
+        state.done = true;
+        std::rethrow_exception(std::exchange(state.error, nullptr));
+      }
+
+      std::optional<LineWorkers<State::Line>::Chunk> chunk{};
+      {
+        nb::gil_scoped_release release{};
+        chunk = state.workers.next();
+      }
+      if (!chunk) {
+        state.done = true;
+        break;
+      }
+      state.lines = std::move(chunk->results);
+      state.error = chunk->error;
+      continue;
+    }
+
+    auto& [line, parsed] = state.lines[state.position++];
+    if (parsed.query) {
+      return state.result(line, *parsed.query, parsed.nodes);
+    }
+
+    DocumentQuery query{*parsed.doc, *state.plan, state.nothing};
+    auto nodes{query.resolve(state.plan->segments)};
+    if (!nodes.empty()) {
+      return state.result(line, query, nodes);
+    }
+  }
+  return std::nullopt;
+}
+
+NDJSONIterator ndjson_iterator(const std::string& path,
+                               std::shared_ptr<const QueryPlan> plan,
+                               nb::object nothing, size_t threads,
+                               bool ordered, bool values) {
+  return NDJSONIterator{std::make_unique<NDJSONIterator::State>(
+      path, std::move(plan), nothing, threads, ordered, values)};
+}
+
+}  // namespace libjsonpath
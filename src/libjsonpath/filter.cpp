@@ -0,0 +1,675 @@
+#include "libjsonpath/filter.hpp"
+
+#include <algorithm>  // std::max
+#include <cstdint>    // std::uint8_t
+#include <mutex>      // std::mutex std::lock_guard
+#include <optional>   // std::optional
+#include <string>     // std::string
+#include <utility>    // std::move, std::pair
+#include <variant>    // std::visit
+#include <vector>     // std::vector
+
+#include "libjsonpath/containers.hpp"
+#include "libjsonpath/utils.hpp"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+bool is_truthy(const nb::object& value) {
+  return !(nb::isinstance<nb::bool_>(value) && !nb::cast<nb::bool_>(value));
+}
+
+namespace {
+
+// The JSON type of a Python object, if it is exactly one of the built-in
+// types used to represent JSON. Instances of subclasses and other types are
+// compared with Python's comparison operators.
+enum class JSONType : std::uint8_t {
+  null,
+  boolean,
+  integer,
+  number,
+  string,
+  array,
+  object,
+  other,
+};
+
+JSONType json_type(PyObject* obj) {
+  if (obj == Py_None) {
+    return JSONType::null;
+  }
+  if (PyBool_Check(obj)) {
+    return JSONType::boolean;
+  }
+  if (PyLong_CheckExact(obj)) {
+    return JSONType::integer;
+  }
+  if (PyFloat_CheckExact(obj)) {
+    return JSONType::number;
+  }
+  if (PyUnicode_CheckExact(obj)) {
+    return JSONType::string;
+  }
+  if (PyList_CheckExact(obj)) {
+    return JSONType::array;
+  }
+  if (PyDict_CheckExact(obj)) {
+    return JSONType::object;
+  }
+  return JSONType::other;
+}
+
+bool is_numeric(JSONType type) {
+  return type == JSONType::boolean || type == JSONType::integer ||
+         type == JSONType::number;
+}
+
+enum class Order : std::uint8_t { less, equal, greater, unordered };
+
+// Doubles represent every integer with a magnitude up to 2**53 exactly.
+constexpr long long max_exact_integer = 1LL << 53;
+
+// The order of two numbers (including bools), or nothing if they can't be
+// compared exactly as C scalars, like ints that don't fit in a long long.
+std::optional<Order> compare_numbers(PyObject* left, JSONType left_type,
+                                     PyObject* right, JSONType right_type) {
+  if (left_type != JSONType::number && right_type != JSONType::number) {
+    int left_overflow{0};
+    int right_overflow{0};
+    long long l{PyLong_AsLongLongAndOverflow(left, &left_overflow)};
+    long long r{PyLong_AsLongLongAndOverflow(right, &right_overflow)};
+    if (left_overflow || right_overflow) {
+      return std::nullopt;
+    }
+    return l < r ? Order::less : l > r ? Order::greater : Order::equal;
+  }
+
+  double values[2]{};
+  PyObject* objects[2]{left, right};
+  JSONType types[2]{left_type, right_type};
+  for (size_t i = 0; i < 2; i++) {
+    if (types[i] == JSONType::number) {
+      values[i] = PyFloat_AsDouble(objects[i]);
+      continue;
+    }
+
+    int overflow{0};
+    long long value{PyLong_AsLongLongAndOverflow(objects[i], &overflow)};
+    if (overflow || value > max_exact_integer || value < -max_exact_integer) {
+      return std::nullopt;
+    }
+    values[i] = static_cast<double>(value);
+  }
+
+  if (values[0] < values[1]) {
+    return Order::less;
+  }
+  if (values[0] > values[1]) {
+    return Order::greater;
+  }
+  return values[0] == values[1] ? Order::equal : Order::unordered;
+}
+
+int string_compare(PyObject* left, PyObject* right) {
+  int rv{PyUnicode_Compare(left, right)};
+  if (rv == -1 && PyErr_Occurred()) {
+    throw nb::python_error();
+  }
+  return rv;
+}
+
+bool python_equal(PyObject* left, PyObject* right) {
+  int rv{PyObject_RichCompareBool(left, right, Py_EQ)};
+  if (rv < 0) {
+    throw nb::python_error();
+  }
+  return rv == 1;
+}
+
+// Arrays and objects nested deeper than this are compared by Python, which
+// raises a RecursionError for cyclic data.
+constexpr size_t max_equal_depth = 256;
+
+// Python's `==` for JSON-like data, without calling into Python for exact
+// built-in types. Like Python's containers, identical objects are always
+// equal.
+bool deep_equal(PyObject* left, PyObject* right, size_t depth) {
+  if (left == right) {
+    return true;
+  }
+
+  JSONType left_type{json_type(left)};
+  JSONType right_type{json_type(right)};
+  if (left_type == JSONType::other || right_type == JSONType::other ||
+      depth > max_equal_depth) {
+    return python_equal(left, right);
+  }
+
+  if (is_numeric(left_type) && is_numeric(right_type)) {
+    auto order{compare_numbers(left, left_type, right, right_type)};
+    if (!order) {
+      return python_equal(left, right);
+    }
+    return *order == Order::equal;
+  }
+
+  if (left_type != right_type) {
+    return false;
+  }
+
+  switch (left_type) {
+    case JSONType::string:
+      return string_compare(left, right) == 0;
+    case JSONType::array: {
+      Py_ssize_t size{PyList_Size(left)};
+      if (size != PyList_Size(right)) {
+        return false;
+      }
+      for (Py_ssize_t i = 0; i < size; i++) {
+        // Hold references in case a Python comparison changes either list.
+        nb::object l{list_item(left, i)};
+        nb::object r{list_item(right, i)};
+        if (!l.is_valid() || !r.is_valid()) {
+          return false;
+        }
+        if (!deep_equal(l.ptr(), r.ptr(), depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case JSONType::object: {
+      if (PyDict_Size(left) != PyDict_Size(right)) {
+        return false;
+      }
+      nb::ft_object_guard guard{left};
+      Py_ssize_t pos{0};
+      PyObject* key{nullptr};
+      PyObject* value{nullptr};
+      while (PyDict_Next(left, &pos, &key, &value)) {
+        nb::object k{nb::borrow(key)};
+        nb::object l{nb::borrow(value)};
+        nb::object r{dict_item(right, k.ptr())};
+        if (!r.is_valid()) {
+          return false;
+        }
+        if (!deep_equal(l.ptr(), r.ptr(), depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      // Both null.
+      return true;
+  }
+}
+
+// Ordering for types without a JSON type, following isinstance checks.
+bool python_less_than(const nb::object& left, const nb::object& right) {
+  if (nb::isinstance<nb::bool_>(left) || nb::isinstance<nb::bool_>(right)) {
+    return false;
+  }
+
+  if (nb::isinstance<nb::str>(left) && nb::isinstance<nb::str>(right)) {
+    return left < right;
+  }
+
+  if ((nb::isinstance<nb::int_>(left) || nb::isinstance<nb::float_>(left)) &&
+      (nb::isinstance<nb::int_>(right) || nb::isinstance<nb::float_>(right))) {
+    return left < right;
+  }
+
+  return false;
+}
+
+bool less_than(const nb::object& left, const nb::object& right) {
+  JSONType left_type{json_type(left.ptr())};
+  JSONType right_type{json_type(right.ptr())};
+
+  if (left_type == JSONType::other || right_type == JSONType::other) {
+    return python_less_than(left, right);
+  }
+
+  if (left_type == JSONType::string && right_type == JSONType::string) {
+    return string_compare(left.ptr(), right.ptr()) < 0;
+  }
+
+  if ((left_type == JSONType::integer || left_type == JSONType::number) &&
+      (right_type == JSONType::integer || right_type == JSONType::number)) {
+    auto order{compare_numbers(left.ptr(), left_type, right.ptr(), right_type)};
+    if (!order) {
+      return python_less_than(left, right);
+    }
+    return *order == Order::less;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+bool equal_objects(const nb::object& left, const nb::object& right) {
+  return deep_equal(left.ptr(), right.ptr(), 0);
+}
+
+bool compare_objects(const nb::object& left, BinaryOperator op,
+                     const nb::object& right) {
+  switch (op) {
+    case BinaryOperator::eq:
+      return equal_objects(left, right);
+    case BinaryOperator::ne:
+      return !equal_objects(left, right);
+    case BinaryOperator::lt:
+      return less_than(left, right);
+    case BinaryOperator::gt:
+      return less_than(right, left);
+    case BinaryOperator::ge:
+      return less_than(right, left) || equal_objects(left, right);
+    case BinaryOperator::le:
+      return less_than(left, right) || equal_objects(left, right);
+    default:
+      return false;
+  }
+}
+
+// Types registered with register_native_function. Types are never released,
+// as they are expected to be classes defined at module level. Queries can be
+// compiled while another thread registers a type, so the registry has a lock.
+static std::vector<std::pair<PyObject*, NativeFunction>>& native_functions() {
+  static std::vector<std::pair<PyObject*, NativeFunction>> types{};
+  return types;
+}
+
+static std::mutex native_functions_mutex{};
+
+void register_native_function(nb::handle type, NativeFunction kind) {
+  std::lock_guard<std::mutex> lock{native_functions_mutex};
+  auto& types{native_functions()};
+  for (auto& [registered, native] : types) {
+    if (registered == type.ptr()) {
+      native = kind;
+      return;
+    }
+  }
+  types.emplace_back(type.inc_ref().ptr(), kind);
+}
+
+static NativeFunction native_function(const nb::callable& func) {
+  PyObject* type{func.type().ptr()};
+  std::lock_guard<std::mutex> lock{native_functions_mutex};
+  for (const auto& [registered, native] : native_functions()) {
+    if (registered == type) {
+      return native;
+    }
+  }
+  return NativeFunction::none;
+}
+
+namespace {
+
+// Compiled code for one sub-expression. If the sub-expression is made only
+// of literals, _constant_ is its value and _code_ is empty.
+struct Fragment {
+  std::vector<Instruction> code{};
+  std::optional<nb::object> constant{};
+  size_t stack_size{0};
+};
+
+class ExpressionCompiler {
+private:
+  FilterProgram& m_program;
+  const function_extension_map& m_functions;
+  const function_signature_map& m_signatures;
+
+  // How many nodes queries in this position need, or zero for all of them.
+  // Tests for existence need one node. Comparisons and logical operators
+  // treat a node list with one node differently from a longer node list, so
+  // they need two. Function arguments need every node.
+  size_t m_limit;
+
+public:
+  ExpressionCompiler(FilterProgram& program,
+                     const function_extension_map& functions,
+                     const function_signature_map& signatures, size_t limit)
+      : m_program{program},
+        m_functions{functions},
+        m_signatures{signatures},
+        m_limit{limit} {}
+
+  Fragment operator()(const NullLiteral&) const { return constant(nb::none()); }
+
+  Fragment operator()(const BooleanLiteral& expression) const {
+    return constant(nb::bool_(expression.value));
+  }
+
+  Fragment operator()(const IntegerLiteral& expression) const {
+    return constant(nb::int_(expression.value));
+  }
+
+  Fragment operator()(const FloatLiteral& expression) const {
+    return constant(nb::float_(expression.value));
+  }
+
+  Fragment operator()(const StringLiteral& expression) const {
+    return constant(nb::str(expression.value.c_str()));
+  }
+
+  Fragment operator()(const Box<LogicalNotExpression>& expression) const {
+    auto right{compile(expression->right, 1)};
+    if (right.constant) {
+      return constant(nb::bool_(!is_truthy(*right.constant)));
+    }
+
+    right.code.push_back({Opcode::logical_not, 0});
+    return right;
+  }
+
+  Fragment operator()(const Box<InfixExpression>& expression) const {
+    auto left{compile(expression->left, 2)};
+    auto right{compile(expression->right, 2)};
+
+    if (expression->op == BinaryOperator::logical_and ||
+        expression->op == BinaryOperator::logical_or) {
+      return logical(std::move(left), expression->op, std::move(right));
+    }
+
+    if (left.constant && right.constant) {
+      return constant(nb::bool_(
+          compare_objects(*left.constant, expression->op, *right.constant)));
+    }
+
+    // Operands that are node lists of one node are compared by value.
+    Fragment rv{};
+    operand(rv, std::move(left), 0);
+    operand(rv, std::move(right), 1);
+    rv.code.push_back({Opcode::compare, static_cast<size_t>(expression->op)});
+    return rv;
+  }
+
+  Fragment operator()(const Box<RelativeQuery>& expression) const {
+    m_program.queries.push_back(
+        {&expression->query, m_limit, singular_query(expression->query)});
+    return {{{Opcode::relative_query, m_program.queries.size() - 1}}, {}, 1};
+  }
+
+  Fragment operator()(const Box<RootQuery>& expression) const {
+    m_program.queries.push_back(
+        {&expression->query, m_limit, singular_query(expression->query)});
+    return {{{Opcode::root_query, m_program.queries.size() - 1}}, {}, 1};
+  }
+
+  Fragment operator()(const Box<FunctionCall>& expression) const {
+    // Arguments are pushed in order and popped by the call.
+    Fragment rv{};
+    size_t index{0};
+    for (const auto& arg : expression->args) {
+      append(rv, emit(compile(arg, 0)), index++);
+    }
+
+    m_program.calls.push_back(bind(*expression));
+    rv.code.push_back({Opcode::call, m_program.calls.size() - 1});
+    rv.stack_size = std::max(rv.stack_size, size_t{1});
+    return rv;
+  }
+
+  Fragment compile(const expression_t& expression, size_t limit) const {
+    return std::visit(
+        ExpressionCompiler{m_program, m_functions, m_signatures, limit},
+        expression);
+  }
+
+  // Materialize constant fragments as a push instruction.
+  Fragment emit(Fragment fragment) const {
+    if (fragment.constant) {
+      m_program.literals.push_back(std::move(*fragment.constant));
+      return {{{Opcode::push, m_program.literals.size() - 1}}, {}, 1};
+    }
+    return fragment;
+  }
+
+private:
+  static Fragment constant(nb::object value) { return {{}, value, 0}; }
+
+  BoundCall bind(const FunctionCall& expression) const {
+    BoundCall call{&expression, {}, {}, NativeFunction::none};
+    auto name{std::string{expression.name}};
+
+    auto it{m_functions.find(name)};
+    if (it != m_functions.end()) {
+      call.func = it->second;
+      call.native = native_function(call.func);
+    }
+
+    if ((call.native == NativeFunction::match ||
+         call.native == NativeFunction::search) &&
+        expression.args.size() == 2) {
+      if (auto pattern = std::get_if<StringLiteral>(&expression.args[1])) {
+        call.pattern = IRegexp::compile(pattern->value);
+      }
+    }
+
+    auto sig_it{m_signatures.find(name)};
+    if (sig_it != m_signatures.end()) {
+      call.signature = sig_it->second;
+    }
+
+    return call;
+  }
+
+  // Short-circuit evaluation of `&&` and `||`. The right operand is only
+  // evaluated if the left operand doesn't decide the result.
+  Fragment logical(Fragment left, BinaryOperator op, Fragment right) const {
+    bool is_and{op == BinaryOperator::logical_and};
+
+    if (left.constant) {
+      if (is_truthy(*left.constant) != is_and) {
+        return constant(nb::bool_(!is_and));
+      }
+      return truthy(std::move(right));
+    }
+
+    if (right.constant) {
+      if (is_truthy(*right.constant) != is_and) {
+        return constant(nb::bool_(!is_and));
+      }
+      return truthy(std::move(left));
+    }
+
+    Fragment rv{};
+    operand(rv, std::move(left), 0);
+    Fragment rest{truthy(std::move(right))};
+    rv.code.push_back({is_and ? Opcode::jump_if_false : Opcode::jump_if_true,
+                       rest.code.size()});
+    append(rv, std::move(rest), 0);
+    return rv;
+  }
+
+  // Code for the truthiness of an operand of a logical operator.
+  Fragment truthy(Fragment fragment) const {
+    if (fragment.constant) {
+      return constant(nb::bool_(is_truthy(*fragment.constant)));
+    }
+
+    Fragment rv{};
+    operand(rv, std::move(fragment), 0);
+    rv.code.push_back({Opcode::truthy, 0});
+    return rv;
+  }
+
+  // Append an infix operand to _rv_, unpacking it if it might be a node list.
+  void operand(Fragment& rv, Fragment fragment, size_t depth) const {
+    bool is_constant{fragment.constant.has_value()};
+    append(rv, emit(std::move(fragment)), depth);
+    if (!is_constant) {
+      rv.code.push_back({Opcode::unpack, 0});
+    }
+  }
+
+  // Append _fragment_ to _rv_, given _depth_ values are already on the stack.
+  static void append(Fragment& rv, Fragment fragment, size_t depth) {
+    rv.code.insert(rv.code.end(), fragment.code.begin(), fragment.code.end());
+    rv.stack_size = std::max(rv.stack_size, depth + fragment.stack_size);
+  }
+};
+
+// Return _value_ as a comparison literal if it is exactly an int that fits in
+// 64 bits, a float or a str.
+std::optional<ComparisonLiteral> comparison_literal(const nb::object& value) {
+  PyObject* obj{value.ptr()};
+  if (PyLong_CheckExact(obj)) {
+    int overflow{0};
+    long long integer{PyLong_AsLongLongAndOverflow(obj, &overflow)};
+    if (overflow || (integer == -1 && PyErr_Occurred())) {
+      PyErr_Clear();
+      return std::nullopt;
+    }
+    return ComparisonLiteral{ComparisonLiteral::Kind::integer, integer, 0.0,
+                             {}};
+  }
+
+  if (PyFloat_CheckExact(obj)) {
+    return ComparisonLiteral{ComparisonLiteral::Kind::real, 0,
+                             PyFloat_AsDouble(obj), {}};
+  }
+
+  if (PyUnicode_CheckExact(obj)) {
+    Py_ssize_t size{0};
+    const char* data{PyUnicode_AsUTF8AndSize(obj, &size)};
+    if (!data) {
+      // Lone surrogates can't be encoded.
+      PyErr_Clear();
+      return std::nullopt;
+    }
+    return ComparisonLiteral{ComparisonLiteral::Kind::string, 0, 0.0,
+                             std::string{data, static_cast<size_t>(size)}};
+  }
+
+  return std::nullopt;
+}
+
+// Recognize `@ op literal`, compiled to [relative_query, unpack, push,
+// compare], and `literal op @`, compiled to [push, relative_query, unpack,
+// compare], where the relative query has no segments.
+std::optional<LiteralComparison> match_literal_comparison(
+    const FilterProgram& program) {
+  const auto& code{program.code};
+  if (code.size() != 4 || code[3].opcode != Opcode::compare) {
+    return std::nullopt;
+  }
+
+  bool reversed{code[0].opcode == Opcode::push};
+  size_t query{reversed ? 1U : 0U};
+  size_t push{reversed ? 0U : 2U};
+  if (code[query].opcode != Opcode::relative_query ||
+      code[query + 1].opcode != Opcode::unpack ||
+      code[push].opcode != Opcode::push ||
+      !program.queries[code[query].operand].segments->empty()) {
+    return std::nullopt;
+  }
+
+  auto literal{comparison_literal(program.literals[code[push].operand])};
+  if (!literal) {
+    return std::nullopt;
+  }
+
+  auto op{static_cast<BinaryOperator>(code[3].operand)};
+  if (reversed) {
+    switch (op) {
+      case BinaryOperator::lt:
+        op = BinaryOperator::gt;
+        break;
+      case BinaryOperator::le:
+        op = BinaryOperator::ge;
+        break;
+      case BinaryOperator::gt:
+        op = BinaryOperator::lt;
+        break;
+      case BinaryOperator::ge:
+        op = BinaryOperator::le;
+        break;
+      default:
+        break;
+    }
+  }
+
+  return LiteralComparison{op, std::move(*literal)};
+}
+
+}  // namespace
+
+FilterProgram::FilterProgram(const expression_t& expression,
+                             const function_extension_map& functions,
+                             const function_signature_map& signatures) {
+  ExpressionCompiler compiler{*this, functions, signatures, 1};
+  auto fragment{compiler.emit(std::visit(compiler, expression))};
+  code = std::move(fragment.code);
+  stack_size = fragment.stack_size;
+  literal_comparison = match_literal_comparison(*this);
+}
+
+FilterPrograms::FilterPrograms(const segments_t& segments,
+                               const function_extension_map& functions,
+                               const function_signature_map& signatures) {
+  for_each_query(segments, [&](const segments_t& query) {
+    for (const auto& segment : query) {
+      const auto& selectors{std::visit(
+          [](const auto& segment_) -> const auto& { return segment_.selectors; },
+          segment)};
+
+      for (const auto& selector : selectors) {
+        if (auto filter = std::get_if<Box<FilterSelector>>(&selector)) {
+          const auto& program{
+              m_programs
+                  .emplace(&(**filter), FilterProgram{(*filter)->expression,
+                                                      functions, signatures})
+                  .first->second};
+          for (const auto& instruction : program.code) {
+            m_root_queries = m_root_queries ||
+                             instruction.opcode == Opcode::root_query;
+          }
+        }
+      }
+    }
+  });
+}
+
+// Call _func_ with queries nested in _expression_.
+static void for_each_query(
+    const expression_t& expression,
+    const std::function<void(const segments_t&)>& func) {
+  if (auto query = std::get_if<Box<RelativeQuery>>(&expression)) {
+    for_each_query((*query)->query, func);
+  } else if (auto query = std::get_if<Box<RootQuery>>(&expression)) {
+    for_each_query((*query)->query, func);
+  } else if (auto not_ = std::get_if<Box<LogicalNotExpression>>(&expression)) {
+    for_each_query((*not_)->right, func);
+  } else if (auto infix = std::get_if<Box<InfixExpression>>(&expression)) {
+    for_each_query((*infix)->left, func);
+    for_each_query((*infix)->right, func);
+  } else if (auto call = std::get_if<Box<FunctionCall>>(&expression)) {
+    for (const auto& arg : (*call)->args) {
+      for_each_query(arg, func);
+    }
+  }
+}
+
+void for_each_query(const segments_t& segments,
+                    const std::function<void(const segments_t&)>& func) {
+  func(segments);
+  for (const auto& segment : segments) {
+    const auto& selectors{std::visit(
+        [](const auto& segment_) -> const auto& { return segment_.selectors; },
+        segment)};
+
+    for (const auto& selector : selectors) {
+      if (auto filter = std::get_if<Box<FilterSelector>>(&selector)) {
+        for_each_query((*filter)->expression, func);
+      }
+    }
+  }
+}
+
+}  // namespace libjsonpath
@@ -0,0 +1,731 @@
+#include "libjsonpath/iregexp.hpp"
+
+#include <limits>   // std::numeric_limits
+#include <utility>  // std::move std::swap
+
+#include "libjsonpath/cache.hpp"
+#include "libjsonpath/unicode_categories.hpp"
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+namespace {
+
+// Patterns that would compile to more instructions than this are rejected,
+// so nested counted repetition like `(a{1000}){1000}` can't exhaust memory.
+constexpr size_t max_program_size = 100000;
+
+// The number of compiled patterns kept by IRegexp::cached.
+constexpr size_t pattern_cache_size = 256;
+
+constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+
+// Decode UTF-8 encoded _text_ to code points, or return false if _text_ is
+// not valid UTF-8.
+bool decode(std::string_view text, std::u32string& out) {
+  size_t i{0};
+  while (i < text.size()) {
+    auto byte{static_cast<unsigned char>(text[i])};
+    size_t length{0};
+    char32_t c{0};
+
+    if (byte < 0x80) {
+      length = 1;
+      c = byte;
+    } else if ((byte & 0xE0) == 0xC0) {
+      length = 2;
+      c = byte & 0x1F;
+    } else if ((byte & 0xF0) == 0xE0) {
+      length = 3;
+      c = byte & 0x0F;
+    } else if ((byte & 0xF8) == 0xF0) {
+      length = 4;
+      c = byte & 0x07;
+    } else {
+      return false;
+    }
+
+    if (i + length > text.size()) {
+      return false;
+    }
+
+    for (size_t j = 1; j < length; j++) {
+      auto continuation{static_cast<unsigned char>(text[i + j])};
+      if ((continuation & 0xC0) != 0x80) {
+        return false;
+      }
+      c = (c << 6) | (continuation & 0x3F);
+    }
+
+    out.push_back(c);
+    i += length;
+  }
+  return true;
+}
+
+// Code points from a string Python has already encoded as valid UTF-8.
+class Utf8Source {
+public:
+  explicit Utf8Source(std::string_view text)
+      : m_it{text.data()}, m_end{text.data() + text.size()} {}
+
+  bool next(char32_t& c) {
+    if (m_it == m_end) {
+      return false;
+    }
+
+    auto byte{static_cast<unsigned char>(*m_it++)};
+    if (byte < 0x80) {
+      c = byte;
+      return true;
+    }
+
+    size_t continuations{byte >= 0xF0 ? 3u : byte >= 0xE0 ? 2u : 1u};
+    c = byte & (0x3F >> continuations);
+    for (size_t i = 0; i < continuations; i++) {
+      c = (c << 6) | (static_cast<unsigned char>(*m_it++) & 0x3F);
+    }
+    return true;
+  }
+
+private:
+  const char* m_it;
+  const char* m_end;
+};
+
+// Code points from a UCS-4 buffer.
+class UCS4Source {
+public:
+  UCS4Source(const Py_UCS4* data, size_t size)
+      : m_it{data}, m_end{data + size} {}
+
+  bool next(char32_t& c) {
+    if (m_it == m_end) {
+      return false;
+    }
+    c = static_cast<char32_t>(*m_it++);
+    return true;
+  }
+
+private:
+  const Py_UCS4* m_it;
+  const Py_UCS4* m_end;
+};
+
+// An I-Regexp syntax tree node.
+struct Node {
+  enum class Kind : std::uint8_t {
+    empty,
+    character,
+    set,
+    concat,
+    alternate,
+    repeat,
+  };
+
+  Kind kind;
+  char32_t c{0};
+  size_t set{0};
+  size_t min{0};
+  size_t max{0};
+  std::vector<Node> children{};
+};
+
+// Thrown by Parser for invalid patterns and by Compiler for patterns that
+// are too big.
+struct InvalidPattern {};
+
+// A recursive descent parser for the I-Regexp grammar in RFC 9485.
+class Parser {
+public:
+  Parser(const std::u32string& pattern, std::vector<IRegexp::CharSet>& sets)
+      : m_pattern{pattern}, m_sets{sets} {}
+
+  Node parse() {
+    Node node{alternate()};
+    if (m_pos != m_pattern.size()) {
+      throw InvalidPattern{};
+    }
+    return node;
+  }
+
+private:
+  const std::u32string& m_pattern;
+  std::vector<IRegexp::CharSet>& m_sets;
+  size_t m_pos{0};
+
+  bool at_end() const { return m_pos == m_pattern.size(); }
+
+  bool peek(char32_t c, size_t offset = 0) const {
+    return m_pos + offset < m_pattern.size() &&
+           m_pattern[m_pos + offset] == c;
+  }
+
+  char32_t next() {
+    if (at_end()) {
+      throw InvalidPattern{};
+    }
+    return m_pattern[m_pos++];
+  }
+
+  void expect(char32_t c) {
+    if (next() != c) {
+      throw InvalidPattern{};
+    }
+  }
+
+  static bool is_surrogate(char32_t c) { return c >= 0xD800 && c <= 0xDFFF; }
+
+  Node alternate() {
+    Node node{Node::Kind::alternate};
+    node.children.push_back(branch());
+    while (peek('|')) {
+      m_pos++;
+      node.children.push_back(branch());
+    }
+    if (node.children.size() == 1) {
+      return std::move(node.children[0]);
+    }
+    return node;
+  }
+
+  Node branch() {
+    Node node{Node::Kind::concat};
+    while (!at_end() && !peek('|') && !peek(')')) {
+      node.children.push_back(piece());
+    }
+    if (node.children.empty()) {
+      return Node{Node::Kind::empty};
+    }
+    if (node.children.size() == 1) {
+      return std::move(node.children[0]);
+    }
+    return node;
+  }
+
+  Node piece() {
+    Node atom_{atom()};
+    size_t min{0};
+    size_t max{0};
+
+    if (peek('*')) {
+      m_pos++;
+      max = unbounded;
+    } else if (peek('+')) {
+      m_pos++;
+      min = 1;
+      max = unbounded;
+    } else if (peek('?')) {
+      m_pos++;
+      max = 1;
+    } else if (peek('{')) {
+      m_pos++;
+      min = number();
+      max = min;
+      if (peek(',')) {
+        m_pos++;
+        max = peek('}') ? unbounded : number();
+      }
+      expect('}');
+      if (max < min) {
+        throw InvalidPattern{};
+      }
+    } else {
+      return atom_;
+    }
+
+    Node node{Node::Kind::repeat};
+    node.min = min;
+    node.max = max;
+    node.children.push_back(std::move(atom_));
+    return node;
+  }
+
+  size_t number() {
+    if (at_end() || m_pattern[m_pos] < '0' || m_pattern[m_pos] > '9') {
+      throw InvalidPattern{};
+    }
+
+    size_t rv{0};
+    while (!at_end() && m_pattern[m_pos] >= '0' && m_pattern[m_pos] <= '9') {
+      rv = rv * 10 + (m_pattern[m_pos++] - '0');
+      if (rv > max_program_size) {
+        throw InvalidPattern{};
+      }
+    }
+    return rv;
+  }
+
+  Node atom() {
+    char32_t c{next()};
+    switch (c) {
+      case '(': {
+        Node node{alternate()};
+        expect(')');
+        return node;
+      }
+      case '.': {
+        IRegexp::CharSet dot{{{'\n', '\n'}, {'\r', '\r'}}, {}, true};
+        return set(std::move(dot));
+      }
+      case '[':
+        return set(class_expression());
+      case '\\':
+        if (peek('p') || peek('P')) {
+          return set(category());
+        }
+        return character(single_char_escape());
+      case ')':
+      case '*':
+      case '+':
+      case '?':
+      case ']':
+      case '{':
+      case '|':
+      case '}':
+        throw InvalidPattern{};
+      default:
+        if (is_surrogate(c)) {
+          throw InvalidPattern{};
+        }
+        return character(c);
+    }
+  }
+
+  static Node character(char32_t c) {
+    Node node{Node::Kind::character};
+    node.c = c;
+    return node;
+  }
+
+  Node set(IRegexp::CharSet set_) {
+    m_sets.push_back(std::move(set_));
+    Node node{Node::Kind::set};
+    node.set = m_sets.size() - 1;
+    return node;
+  }
+
+  // The character after a backslash, other than `p` or `P`.
+  char32_t single_char_escape() {
+    char32_t c{next()};
+    switch (c) {
+      case 'n':
+        return '\n';
+      case 'r':
+        return '\r';
+      case 't':
+        return '\t';
+      case '(':
+      case ')':
+      case '*':
+      case '+':
+      case '-':
+      case '.':
+      case '?':
+      case '[':
+      case '\\':
+      case ']':
+      case '^':
+      case '{':
+      case '|':
+      case '}':
+        return c;
+      default:
+        throw InvalidPattern{};
+    }
+  }
+
+  // `\p{...}` or `\P{...}`, after the backslash.
+  IRegexp::CharSet category() {
+    bool negated{next() == 'P'};
+    expect('{');
+
+    std::string name{};
+    while (!peek('}') && name.size() < 2) {
+      char32_t c{next()};
+      if (c > 0x7F) {
+        throw InvalidPattern{};
+      }
+      name.push_back(static_cast<char>(c));
+    }
+    expect('}');
+
+    static const std::string_view categories[] = {
+        "L",  "Lu", "Ll", "Lt", "Lm", "Lo", "M",  "Mn", "Mc", "Me", "N",
+        "Nd", "Nl", "No", "P",  "Pc", "Pd", "Ps", "Pe", "Pi", "Pf", "Po",
+        "Z",  "Zs", "Zl", "Zp", "S",  "Sm", "Sc", "Sk", "So", "C",  "Cc",
+        "Cf", "Cn", "Co"};
+
+    for (const auto& category_ : categories) {
+      if (category_ == name) {
+        return {{}, {{name, negated}}, false};
+      }
+    }
+    throw InvalidPattern{};
+  }
+
+  // A character class expression, like `[^a-z]`, after the opening bracket.
+  IRegexp::CharSet class_expression() {
+    IRegexp::CharSet rv{};
+    if (peek('^')) {
+      m_pos++;
+      rv.negated = true;
+    }
+
+    if (peek('-')) {
+      m_pos++;
+      rv.ranges.emplace_back('-', '-');
+    } else {
+      class_element(rv);
+    }
+
+    while (!peek(']')) {
+      if (peek('-') && peek(']', 1)) {
+        m_pos++;
+        rv.ranges.emplace_back('-', '-');
+        break;
+      }
+      class_element(rv);
+    }
+
+    expect(']');
+    return rv;
+  }
+
+  void class_element(IRegexp::CharSet& rv) {
+    if (peek('\\') && (peek('p', 1) || peek('P', 1))) {
+      m_pos++;
+      auto category_{category()};
+      rv.categories.push_back(std::move(category_.categories[0]));
+      return;
+    }
+
+    char32_t lo{class_char()};
+    char32_t hi{lo};
+    if (peek('-') && !peek(']', 1)) {
+      m_pos++;
+      hi = class_char();
+      if (hi < lo) {
+        throw InvalidPattern{};
+      }
+    }
+    rv.ranges.emplace_back(lo, hi);
+  }
+
+  char32_t class_char() {
+    char32_t c{next()};
+    if (c == '\\') {
+      return single_char_escape();
+    }
+    if (c == '-' || c == '[' || c == ']' || is_surrogate(c)) {
+      throw InvalidPattern{};
+    }
+    return c;
+  }
+};
+
+// Compile a syntax tree to a program for IRegexp::run.
+class Compiler {
+public:
+  std::vector<IRegexp::Instruction> program{};
+
+  void compile(const Node& node) {
+    emit(node);
+    push({IRegexp::Opcode::match, 0, 0, 0});
+  }
+
+private:
+  size_t push(IRegexp::Instruction instruction) {
+    if (program.size() >= max_program_size) {
+      throw InvalidPattern{};
+    }
+    program.push_back(instruction);
+    return program.size() - 1;
+  }
+
+  void emit(const Node& node) {
+    switch (node.kind) {
+      case Node::Kind::empty:
+        break;
+      case Node::Kind::character:
+        push({IRegexp::Opcode::character, node.c, 0, 0});
+        break;
+      case Node::Kind::set:
+        push({IRegexp::Opcode::set, 0, node.set, 0});
+        break;
+      case Node::Kind::concat:
+        for (const auto& child : node.children) {
+          emit(child);
+        }
+        break;
+      case Node::Kind::alternate: {
+        std::vector<size_t> jumps{};
+        for (size_t i = 0; i < node.children.size(); i++) {
+          if (i + 1 == node.children.size()) {
+            emit(node.children[i]);
+            break;
+          }
+          size_t split{push({IRegexp::Opcode::split, 0, 0, 0})};
+          program[split].x = split + 1;
+          emit(node.children[i]);
+          jumps.push_back(push({IRegexp::Opcode::jump, 0, 0, 0}));
+          program[split].y = program.size();
+        }
+        for (size_t jump : jumps) {
+          program[jump].x = program.size();
+        }
+        break;
+      }
+      case Node::Kind::repeat:
+        repeat(node);
+        break;
+    }
+  }
+
+  void repeat(const Node& node) {
+    const Node& child{node.children[0]};
+    for (size_t i = 0; i < node.min; i++) {
+      emit(child);
+    }
+
+    if (node.max == unbounded) {
+      size_t split{push({IRegexp::Opcode::split, 0, 0, 0})};
+      program[split].x = split + 1;
+      emit(child);
+      push({IRegexp::Opcode::jump, 0, split, 0});
+      program[split].y = program.size();
+      return;
+    }
+
+    // Optional repetitions skip to the end.
+    std::vector<size_t> splits{};
+    for (size_t i = node.min; i < node.max; i++) {
+      size_t split{push({IRegexp::Opcode::split, 0, 0, 0})};
+      program[split].x = split + 1;
+      splits.push_back(split);
+      emit(child);
+    }
+    for (size_t split : splits) {
+      program[split].y = program.size();
+    }
+  }
+};
+
+// Append _c_ to _out_ as UTF-8.
+void encode(char32_t c, std::string& out) {
+  if (c < 0x80) {
+    out.push_back(static_cast<char>(c));
+  } else if (c < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+    out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  } else if (c < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  }
+}
+
+// The string matched by _node_ if it is a sequence of characters.
+std::optional<std::string> literal(const Node& node) {
+  std::string rv{};
+  if (node.kind == Node::Kind::empty) {
+    return rv;
+  }
+
+  if (node.kind == Node::Kind::character) {
+    encode(node.c, rv);
+    return rv;
+  }
+
+  if (node.kind != Node::Kind::concat) {
+    return std::nullopt;
+  }
+
+  for (const auto& child : node.children) {
+    if (child.kind != Node::Kind::character) {
+      return std::nullopt;
+    }
+    encode(child.c, rv);
+  }
+  return rv;
+}
+
+}  // namespace
+
+bool IRegexp::CharSet::contains(char32_t c) const {
+  bool found{false};
+  for (const auto& [lo, hi] : ranges) {
+    if (c >= lo && c <= hi) {
+      found = true;
+      break;
+    }
+  }
+
+  if (!found && !categories.empty()) {
+    std::string_view category{general_category(c)};
+    for (const auto& [name, negated] : categories) {
+      // Single letter names match every category in their group.
+      bool in_category{name.size() == 1 ? category[0] == name[0]
+                                        : category == name};
+      if (in_category != negated) {
+        found = true;
+        break;
+      }
+    }
+  }
+
+  return found != negated;
+}
+
+std::shared_ptr<const IRegexp> IRegexp::compile(std::string_view pattern) {
+  std::u32string code_points{};
+  if (!decode(pattern, code_points)) {
+    return nullptr;
+  }
+
+  try {
+    std::vector<CharSet> sets{};
+    Node node{Parser{code_points, sets}.parse()};
+    Compiler compiler{};
+    compiler.compile(node);
+    return std::make_shared<const IRegexp>(std::move(compiler.program),
+                                           std::move(sets), literal(node));
+  } catch (const InvalidPattern&) {
+    return nullptr;
+  }
+}
+
+std::shared_ptr<const IRegexp> IRegexp::cached(std::string_view pattern) {
+  static LRUCache<std::shared_ptr<const IRegexp>> cache{pattern_cache_size};
+  return cache.get_or_insert(pattern, [pattern]() { return compile(pattern); });
+}
+
+std::shared_ptr<const IRegexp> IRegexp::cached(nb::handle pattern) {
+  if (!nb::isinstance<nb::str>(pattern)) {
+    return nullptr;
+  }
+
+  Py_ssize_t size{0};
+  const char* data{PyUnicode_AsUTF8AndSize(pattern.ptr(), &size)};
+  if (!data) {
+    PyErr_Clear();
+    return nullptr;
+  }
+  return cached(std::string_view{data, static_cast<size_t>(size)});
+}
+
+bool IRegexp::test(nb::handle string, bool anchored) const {
+  Py_ssize_t size{0};
+  const char* data{PyUnicode_AsUTF8AndSize(string.ptr(), &size)};
+  if (data) {
+    std::string_view view{data, static_cast<size_t>(size)};
+    if (m_literal) {
+      return anchored ? view == *m_literal
+                      : view.find(*m_literal) != std::string_view::npos;
+    }
+    return run(Utf8Source{view}, anchored);
+  }
+
+  // Strings containing lone surrogates can't be encoded as UTF-8.
+  PyErr_Clear();
+  Py_UCS4* buffer{PyUnicode_AsUCS4Copy(string.ptr())};
+  if (!buffer) {
+    throw nb::python_error();
+  }
+
+  bool rv{false};
+  try {
+    rv = run(UCS4Source{buffer,
+                        static_cast<size_t>(PyUnicode_GetLength(string.ptr()))},
+             anchored);
+  } catch (...) {
+    PyMem_Free(buffer);
+    throw;
+  }
+  PyMem_Free(buffer);
+  return rv;
+}
+
+// Simulate the automaton on every character from _source_, tracking the set
+// of instructions reachable so far. If _anchored_ is false, a new match can
+// start at every character.
+template <typename Source>
+bool IRegexp::run(Source source, bool anchored) const {
+  const size_t size{m_program.size()};
+  std::vector<size_t> current{};
+  std::vector<size_t> next{};
+  std::vector<size_t> stack{};
+  std::vector<size_t> marks(size, unbounded);
+  current.reserve(size);
+  next.reserve(size);
+
+  // Add _pc_ and everything reachable from it without consuming a character
+  // to _threads_, unless they were already added in this _step_.
+  auto add = [&](std::vector<size_t>& threads, size_t pc, size_t step) {
+    stack.push_back(pc);
+    while (!stack.empty()) {
+      pc = stack.back();
+      stack.pop_back();
+      if (marks[pc] == step) {
+        continue;
+      }
+      marks[pc] = step;
+
+      const Instruction& instruction{m_program[pc]};
+      switch (instruction.opcode) {
+        case Opcode::jump:
+          stack.push_back(instruction.x);
+          break;
+        case Opcode::split:
+          stack.push_back(instruction.y);
+          stack.push_back(instruction.x);
+          break;
+        default:
+          threads.push_back(pc);
+      }
+    }
+  };
+
+  size_t step{0};
+  add(current, 0, step);
+
+  char32_t c{0};
+  while (true) {
+    bool more{source.next(c)};
+
+    for (size_t pc : current) {
+      if (m_program[pc].opcode == Opcode::match && (!anchored || !more)) {
+        return true;
+      }
+    }
+
+    if (!more || (anchored && current.empty())) {
+      return false;
+    }
+
+    step++;
+    next.clear();
+    for (size_t pc : current) {
+      const Instruction& instruction{m_program[pc]};
+      if ((instruction.opcode == Opcode::character && instruction.c == c) ||
+          (instruction.opcode == Opcode::set &&
+           m_sets[instruction.x].contains(c))) {
+        add(next, pc + 1, step);
+      }
+    }
+
+    if (!anchored) {
+      add(next, 0, step);
+    }
+
+    std::swap(current, next);
+  }
+}
+
+}  // namespace libjsonpath
@@ -0,0 +1,380 @@
+#include "libjsonpath/kernels.hpp"
+
+#include <algorithm>    // std::copy std::min
+#include <cstring>      // std::memcpy
+#include <type_traits>  // std::integral_constant
+
+// SSE2 is part of x86-64. AVX2 kernels are compiled for any x86-64 CPU and
+// only used if the CPU has AVX2. Define LIBJSONPATH_SCALAR_KERNELS to use
+// the portable loops everywhere.
+#if !defined(LIBJSONPATH_SCALAR_KERNELS) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define LIBJSONPATH_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace libjsonpath {
+
+namespace {
+
+// Doubles represent every integer with a magnitude up to 2**53 exactly.
+constexpr std::int64_t max_exact_integer = std::int64_t{1} << 53;
+
+bool exact(std::int64_t value) {
+  return value >= -max_exact_integer && value <= max_exact_integer;
+}
+
+// Call _kernel_ with _op_ as a compile time constant. Return false if _op_
+// isn't a comparison.
+template <typename Kernel>
+bool with_operator(BinaryOperator op, Kernel&& kernel) {
+  switch (op) {
+    case BinaryOperator::eq:
+      kernel(std::integral_constant<BinaryOperator, BinaryOperator::eq>{});
+      return true;
+    case BinaryOperator::ne:
+      kernel(std::integral_constant<BinaryOperator, BinaryOperator::ne>{});
+      return true;
+    case BinaryOperator::lt:
+      kernel(std::integral_constant<BinaryOperator, BinaryOperator::lt>{});
+      return true;
+    case BinaryOperator::le:
+      kernel(std::integral_constant<BinaryOperator, BinaryOperator::le>{});
+      return true;
+    case BinaryOperator::gt:
+      kernel(std::integral_constant<BinaryOperator, BinaryOperator::gt>{});
+      return true;
+    case BinaryOperator::ge:
+      kernel(std::integral_constant<BinaryOperator, BinaryOperator::ge>{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Like compare_objects. Written with only `==` and `<`, so NaN is unequal to
+// and unordered with everything, like it is in Python.
+template <BinaryOperator Op, typename T>
+bool test(const T& left, const T& right) {
+  if constexpr (Op == BinaryOperator::eq) {
+    return left == right;
+  } else if constexpr (Op == BinaryOperator::ne) {
+    return !(left == right);
+  } else if constexpr (Op == BinaryOperator::lt) {
+    return left < right;
+  } else if constexpr (Op == BinaryOperator::le) {
+    return left < right || left == right;
+  } else if constexpr (Op == BinaryOperator::gt) {
+    return right < left;
+  } else {
+    return right < left || left == right;
+  }
+}
+
+void select(std::uint64_t* bits, size_t index) {
+  bits[index / 64] |= std::uint64_t{1} << (index % 64);
+}
+
+// Compare items from _begin_ onwards, one at a time.
+template <BinaryOperator Op, typename T>
+void compare_scalar(const T* values, size_t begin, size_t size, T literal,
+                    std::uint64_t* bits) {
+  for (size_t i = begin; i < size; i++) {
+    if (test<Op>(values[i], literal)) {
+      select(bits, i);
+    }
+  }
+}
+
+#ifdef LIBJSONPATH_X86_KERNELS
+
+bool has_avx2() {
+  static const bool rv{__builtin_cpu_supports("avx2") != 0};
+  return rv;
+}
+
+// Vector kernels fill whole words of the bitmap and return the number of
+// items they compared. The rest are left to compare_scalar.
+
+template <BinaryOperator Op>
+__m128d compare_sse2(__m128d left, __m128d right) {
+  if constexpr (Op == BinaryOperator::eq) {
+    return _mm_cmpeq_pd(left, right);
+  } else if constexpr (Op == BinaryOperator::ne) {
+    return _mm_cmpneq_pd(left, right);
+  } else if constexpr (Op == BinaryOperator::lt) {
+    return _mm_cmplt_pd(left, right);
+  } else if constexpr (Op == BinaryOperator::le) {
+    return _mm_cmple_pd(left, right);
+  } else if constexpr (Op == BinaryOperator::gt) {
+    return _mm_cmpgt_pd(left, right);
+  } else {
+    return _mm_cmpge_pd(left, right);
+  }
+}
+
+template <BinaryOperator Op>
+size_t compare_reals_sse2(const double* values, size_t size, double literal,
+                          std::uint64_t* bits) {
+  const __m128d right{_mm_set1_pd(literal)};
+  size_t words{size / 64};
+  for (size_t w = 0; w < words; w++) {
+    std::uint64_t word{0};
+    const double* chunk{values + w * 64};
+    for (size_t i = 0; i < 64; i += 2) {
+      __m128d left{_mm_loadu_pd(chunk + i)};
+      auto mask{_mm_movemask_pd(compare_sse2<Op>(left, right))};
+      word |= static_cast<std::uint64_t>(mask) << i;
+    }
+    bits[w] = word;
+  }
+  return words * 64;
+}
+
+// Ordered predicates are false for NaN, and the unordered `!=` is true.
+template <BinaryOperator Op>
+constexpr int avx_predicate() {
+  if constexpr (Op == BinaryOperator::eq) {
+    return _CMP_EQ_OQ;
+  } else if constexpr (Op == BinaryOperator::ne) {
+    return _CMP_NEQ_UQ;
+  } else if constexpr (Op == BinaryOperator::lt) {
+    return _CMP_LT_OQ;
+  } else if constexpr (Op == BinaryOperator::le) {
+    return _CMP_LE_OQ;
+  } else if constexpr (Op == BinaryOperator::gt) {
+    return _CMP_GT_OQ;
+  } else {
+    return _CMP_GE_OQ;
+  }
+}
+
+template <BinaryOperator Op>
+__attribute__((target("avx2"))) size_t compare_reals_avx2(
+    const double* values, size_t size, double literal, std::uint64_t* bits) {
+  const __m256d right{_mm256_set1_pd(literal)};
+  size_t words{size / 64};
+  for (size_t w = 0; w < words; w++) {
+    std::uint64_t word{0};
+    const double* chunk{values + w * 64};
+    for (size_t i = 0; i < 64; i += 4) {
+      __m256d left{_mm256_loadu_pd(chunk + i)};
+      auto mask{_mm256_movemask_pd(
+          _mm256_cmp_pd(left, right, avx_predicate<Op>()))};
+      word |= static_cast<std::uint64_t>(mask) << i;
+    }
+    bits[w] = word;
+  }
+  return words * 64;
+}
+
+template <BinaryOperator Op>
+__attribute__((target("avx2"))) size_t compare_integers_avx2(
+    const std::int64_t* values, size_t size, std::int64_t literal,
+    std::uint64_t* bits) {
+  const __m256i right{_mm256_set1_epi64x(literal)};
+  size_t words{size / 64};
+  for (size_t w = 0; w < words; w++) {
+    std::uint64_t word{0};
+    const std::int64_t* chunk{values + w * 64};
+    for (size_t i = 0; i < 64; i += 4) {
+      __m256i left{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk + i))};
+      __m256i rv{};
+      // AVX2 only has `==` and `>`. The other comparisons are their
+      // complements, which are exact for integers.
+      if constexpr (Op == BinaryOperator::eq || Op == BinaryOperator::ne) {
+        rv = _mm256_cmpeq_epi64(left, right);
+      } else if constexpr (Op == BinaryOperator::gt ||
+                           Op == BinaryOperator::le) {
+        rv = _mm256_cmpgt_epi64(left, right);
+      } else {
+        rv = _mm256_cmpgt_epi64(right, left);
+      }
+      auto mask{_mm256_movemask_pd(_mm256_castsi256_pd(rv))};
+      if constexpr (Op == BinaryOperator::ne || Op == BinaryOperator::le ||
+                    Op == BinaryOperator::ge) {
+        mask = ~mask & 0xf;
+      }
+      word |= static_cast<std::uint64_t>(mask) << i;
+    }
+    bits[w] = word;
+  }
+  return words * 64;
+}
+
+// Compare 16 bytes of each string slot, and its length, at once.
+size_t equal_strings_sse2(const char* slots, const std::uint8_t* lengths,
+                          size_t size, const char* literal,
+                          std::uint8_t length, std::uint64_t* bits) {
+  static_assert(ComparisonColumn::short_string_size == 16);
+  const __m128i right{
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(literal))};
+  size_t words{size / 64};
+  for (size_t w = 0; w < words; w++) {
+    std::uint64_t word{0};
+    for (size_t i = 0; i < 64; i++) {
+      size_t item{w * 64 + i};
+      __m128i left{
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots + item * 16))};
+      bool equal{_mm_movemask_epi8(_mm_cmpeq_epi8(left, right)) == 0xffff &&
+                 lengths[item] == length};
+      word |= static_cast<std::uint64_t>(equal) << i;
+    }
+    bits[w] = word;
+  }
+  return words * 64;
+}
+
+#endif
+
+template <BinaryOperator Op>
+void compare_reals(const double* values, size_t size, double literal,
+                   std::uint64_t* bits) {
+  size_t done{0};
+#ifdef LIBJSONPATH_X86_KERNELS
+  done = has_avx2() ? compare_reals_avx2<Op>(values, size, literal, bits)
+                    : compare_reals_sse2<Op>(values, size, literal, bits);
+#endif
+  compare_scalar<Op>(values, done, size, literal, bits);
+}
+
+template <BinaryOperator Op>
+void compare_integers(const std::int64_t* values, size_t size,
+                      std::int64_t literal, std::uint64_t* bits) {
+  size_t done{0};
+#ifdef LIBJSONPATH_X86_KERNELS
+  if (has_avx2()) {
+    done = compare_integers_avx2<Op>(values, size, literal, bits);
+  }
+#endif
+  compare_scalar<Op>(values, done, size, literal, bits);
+}
+
+}  // namespace
+
+bool ComparisonColumn::push_integer(std::int64_t value) {
+  switch (m_kind) {
+    case Kind::string:
+      return false;
+    case Kind::real:
+      if (!exact(value)) {
+        return false;
+      }
+      m_reals.push_back(static_cast<double>(value));
+      break;
+    default:
+      m_kind = Kind::integer;
+      m_exact = m_exact && exact(value);
+      m_integers.push_back(value);
+  }
+  m_size++;
+  return true;
+}
+
+bool ComparisonColumn::push_real(double value) {
+  if (m_kind == Kind::string) {
+    return false;
+  }
+
+  // Integers mixed with floats are stored as doubles, if that's exact.
+  if (m_kind == Kind::integer) {
+    if (!m_exact) {
+      return false;
+    }
+    m_reals.assign(m_integers.begin(), m_integers.end());
+    m_integers.clear();
+  }
+
+  m_kind = Kind::real;
+  m_reals.push_back(value);
+  m_size++;
+  return true;
+}
+
+bool ComparisonColumn::push_string(std::string_view value) {
+  if ((m_kind != Kind::empty && m_kind != Kind::string) ||
+      value.size() > short_string_size) {
+    return false;
+  }
+
+  m_kind = Kind::string;
+  m_strings.resize(m_strings.size() + short_string_size, '\0');
+  std::copy(value.begin(), value.end(),
+            m_strings.end() - static_cast<std::ptrdiff_t>(short_string_size));
+  m_lengths.push_back(static_cast<std::uint8_t>(value.size()));
+  m_size++;
+  return true;
+}
+
+std::optional<bitmap_t> ComparisonColumn::compare(
+    BinaryOperator op, const ComparisonLiteral& literal) const {
+  bitmap_t rv((m_size + 63) / 64, 0);
+  std::uint64_t* bits{rv.data()};
+  bool compared{false};
+
+  switch (m_kind) {
+    case Kind::empty:
+      return rv;
+    case Kind::integer:
+      if (literal.kind == ComparisonLiteral::Kind::integer) {
+        compared = with_operator(op, [&](auto op_) {
+          compare_integers<op_.value>(m_integers.data(), m_size,
+                                      literal.integer, bits);
+        });
+      } else if (literal.kind == ComparisonLiteral::Kind::real && m_exact) {
+        std::vector<double> reals(m_integers.begin(), m_integers.end());
+        compared = with_operator(op, [&](auto op_) {
+          compare_reals<op_.value>(reals.data(), m_size, literal.real, bits);
+        });
+      }
+      break;
+    case Kind::real:
+      if (literal.kind == ComparisonLiteral::Kind::real ||
+          (literal.kind == ComparisonLiteral::Kind::integer &&
+           exact(literal.integer))) {
+        double right{literal.kind == ComparisonLiteral::Kind::real
+                         ? literal.real
+                         : static_cast<double>(literal.integer)};
+        compared = with_operator(op, [&](auto op_) {
+          compare_reals<op_.value>(m_reals.data(), m_size, right, bits);
+        });
+      }
+      break;
+    case Kind::string:
+      if (literal.kind != ComparisonLiteral::Kind::string) {
+        break;
+      }
+      compared = with_operator(op, [&](auto op_) {
+        constexpr BinaryOperator Op{op_.value};
+        size_t done{0};
+#ifdef LIBJSONPATH_X86_KERNELS
+        if constexpr (Op == BinaryOperator::eq) {
+          if (literal.string.size() <= short_string_size) {
+            char padded[short_string_size]{};
+            std::memcpy(padded, literal.string.data(), literal.string.size());
+            done = equal_strings_sse2(
+                m_strings.data(), m_lengths.data(), m_size, padded,
+                static_cast<std::uint8_t>(literal.string.size()), bits);
+          }
+        }
+#endif
+        std::string_view right{literal.string};
+        for (size_t i = done; i < m_size; i++) {
+          std::string_view left{m_strings.data() + i * short_string_size,
+                                m_lengths[i]};
+          if (test<Op>(left, right)) {
+            select(bits, i);
+          }
+        }
+      });
+      break;
+  }
+
+  if (!compared) {
+    return std::nullopt;
+  }
+  return rv;
+}
+
+}  // namespace libjsonpath
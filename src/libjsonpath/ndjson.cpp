@@ -0,0 +1,127 @@
+#include "libjsonpath/ndjson.hpp"
+
+#include <string>  // std::string
+
+#include "nanobind/nanobind.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap munmap madvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#endif
+
+namespace nb = nanobind;
+
+namespace libjsonpath {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+  std::wstring wide(
+      MultiByteToWideChar(CP_UTF8, 0, path.data(),
+                          static_cast<int>(path.size()), nullptr, 0),
+      L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()),
+                      wide.data(), static_cast<int>(wide.size()));
+
+  HANDLE file{CreateFileW(wide.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                          nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                          nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    PyErr_SetExcFromWindowsErrWithFilename(PyExc_OSError, 0, path.c_str());
+    throw nb::python_error();
+  }
+  m_file = file;
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size)) {
+    PyErr_SetExcFromWindowsErrWithFilename(PyExc_OSError, 0, path.c_str());
+    CloseHandle(file);
+    throw nb::python_error();
+  }
+
+  // Empty files can't be mapped.
+  m_size = static_cast<size_t>(size.QuadPart);
+  if (!m_size) {
+    return;
+  }
+
+  HANDLE mapping{
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+  void* data{mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                     : nullptr};
+  if (!data) {
+    PyErr_SetExcFromWindowsErrWithFilename(PyExc_OSError, 0, path.c_str());
+    if (mapping) {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    throw nb::python_error();
+  }
+  m_mapping = mapping;
+  m_data = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file) {
+    CloseHandle(m_file);
+  }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+  int fd{open(path.c_str(), O_RDONLY)};
+  if (fd == -1) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path.c_str());
+    throw nb::python_error();
+  }
+
+  struct stat info {};
+  if (fstat(fd, &info) == -1) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path.c_str());
+    close(fd);
+    throw nb::python_error();
+  }
+
+  // Empty files can't be mapped. The descriptor isn't needed once the file
+  // is mapped.
+  m_size = static_cast<size_t>(info.st_size);
+  if (!m_size) {
+    close(fd);
+    return;
+  }
+
+  void* data{mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+  if (data == MAP_FAILED) {
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, path.c_str());
+    close(fd);
+    throw nb::python_error();
+  }
+  close(fd);
+
+  madvise(data, m_size, MADV_SEQUENTIAL);
+  m_data = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+#endif
+
+}  // namespace libjsonpath
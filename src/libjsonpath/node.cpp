@@ -1,28 +1,115 @@
 #include "libjsonpath/node.hpp"
 
+#include <utility>  // std::move
+
+#include "nanobind/stl/string.h"
+
 namespace nb = nanobind;
 
 namespace libjsonpath {
 
 using namespace std::string_literals;
 
+constexpr char hex_digits[] = "0123456789abcdef";
+
 struct LocationVisitor {
+  std::variant<size_t, std::string> operator()(const size_t& index) const {
+    return index;
+  }
+
+  std::variant<size_t, std::string> operator()(const nb::str& name) const {
+    // We kept getting std::bad_cast when trying to use nb::cast<std::string>,
+    // but only in some cases on some os/py versions.
+    std::string rv{};
+    nb::try_cast<std::string>(name, rv);
+    return rv;  // XXX: empty string if cast fails
+  }
+};
+
+struct PathVisitor {
   std::string operator()(const size_t& index) const {
     return std::to_string(index);
   }
 
+  // Names are quoted and escaped as in a normalized path (RFC 9535 section
+  // 2.7). Only ASCII characters are escaped, so _name_ is read byte by byte.
   std::string operator()(const std::string& name) const {
-    return "'"s + name + "'"s;
+    std::string rv{"'"};
+    for (char c : name) {
+      switch (c) {
+        case '\'':
+          rv.append("\\'");
+          break;
+        case '\\':
+          rv.append("\\\\");
+          break;
+        case '\b':
+          rv.append("\\b");
+          break;
+        case '\f':
+          rv.append("\\f");
+          break;
+        case '\n':
+          rv.append("\\n");
+          break;
+        case '\r':
+          rv.append("\\r");
+          break;
+        case '\t':
+          rv.append("\\t");
+          break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            rv.append("\\u00");
+            rv.push_back(hex_digits[(c >> 4) & 0xF]);
+            rv.push_back(hex_digits[c & 0xF]);
+          } else {
+            rv.push_back(c);
+          }
+      }
+    }
+    rv.push_back('\'');
+    return rv;
   }
 };
 
-JSONPathNode::JSONPathNode(nb::object& value_, location_t location_)
-    : value{value_}, location{location_} {}
+LocationStep::~LocationStep() {
+  // Release ancestors we hold the last reference to one at a time, rather
+  // than recursing once per step on deep chains.
+  auto next{std::move(parent)};
+  while (next && next.use_count() == 1) {
+    next = std::move(next->parent);
+  }
+}
 
-std::string JSONPathNode::path() {
+JSONPathNode::JSONPathNode(nb::object& value_, location_chain_t chain_)
+    : value{value_}, m_chain{std::move(chain_)} {}
+
+JSONPathNode JSONPathNode::child(nb::object& value_, size_t index) const {
+  size_t depth{m_chain ? m_chain->depth + 1 : 1};
+  return {value_, std::make_shared<LocationStep>(
+                      LocationStep{m_chain, index, depth})};
+}
+
+JSONPathNode JSONPathNode::child(nb::object& value_, nb::str name) const {
+  size_t depth{m_chain ? m_chain->depth + 1 : 1};
+  return {value_, std::make_shared<LocationStep>(
+                      LocationStep{m_chain, std::move(name), depth})};
+}
+
+location_t JSONPathNode::location() const {
+  location_t rv(m_chain ? m_chain->depth : 0);
   LocationVisitor visitor{};
+  for (auto step{m_chain.get()}; step; step = step->parent.get()) {
+    rv[step->depth - 1] = std::visit(visitor, step->key);
+  }
+  return rv;
+}
+
+std::string JSONPathNode::path() const {
+  PathVisitor visitor{};
   auto rv = "$"s;
-  for (auto item : location) {
+  for (const auto& item : location()) {
     rv.push_back('[');
     rv.append(std::visit(visitor, item));
     rv.push_back(']');
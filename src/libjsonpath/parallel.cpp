@@ -0,0 +1,200 @@
+#include "libjsonpath/parallel.hpp"
+
+#include <algorithm>  // std::min std::max
+#include <atomic>     // std::atomic
+#include <exception>  // std::exception_ptr std::rethrow_exception
+
+namespace libjsonpath {
+
+namespace {
+
+// The tasks a thread has yet to start, from _begin_ up to _end_. Owners take
+// from the front and thieves take from the back.
+struct Share {
+  std::mutex mutex{};
+  size_t begin{0};
+  size_t end{0};
+};
+
+class Scheduler {
+public:
+  Scheduler(size_t tasks, size_t threads,
+            const std::function<void(size_t)>& task)
+      : m_shares(threads), m_task{task} {
+    for (size_t i = 0; i < threads; i++) {
+      m_shares[i].begin = tasks * i / threads;
+      m_shares[i].end = tasks * (i + 1) / threads;
+    }
+  }
+
+  void run(size_t thread) {
+    Share& own{m_shares[thread]};
+    while (!m_failed.load(std::memory_order_relaxed)) {
+      size_t index{0};
+      if (!take(own, index)) {
+        if (!steal(own)) {
+          return;
+        }
+        continue;
+      }
+
+      try {
+        m_task(index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{m_error_mutex};
+        if (!m_error) {
+          m_error = std::current_exception();
+        }
+        m_failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void rethrow() const {
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+private:
+  std::vector<Share> m_shares;
+  const std::function<void(size_t)>& m_task;
+  std::atomic<bool> m_failed{false};
+  std::mutex m_error_mutex{};
+  std::exception_ptr m_error{};
+
+  // Take the next task from the front of _share_.
+  static bool take(Share& share, size_t& index) {
+    std::lock_guard<std::mutex> lock{share.mutex};
+    if (share.begin == share.end) {
+      return false;
+    }
+    index = share.begin++;
+    return true;
+  }
+
+  // Move the second half of the largest share left into _own_, which is
+  // empty. Only one lock is held at a time, so thieves can't deadlock.
+  // Returns false if every share is empty.
+  bool steal(Share& own) {
+    while (true) {
+      Share* victim{nullptr};
+      size_t most{0};
+      for (auto& share : m_shares) {
+        std::lock_guard<std::mutex> lock{share.mutex};
+        if (share.end - share.begin > most) {
+          most = share.end - share.begin;
+          victim = &share;
+        }
+      }
+      if (!victim) {
+        return false;
+      }
+
+      size_t begin{0};
+      size_t end{0};
+      {
+        std::lock_guard<std::mutex> lock{victim->mutex};
+        size_t left{victim->end - victim->begin};
+        if (!left) {
+          // Another thief got there first.
+          continue;
+        }
+        end = victim->end;
+        begin = end - (left + 1) / 2;
+        victim->end = begin;
+      }
+
+      std::lock_guard<std::mutex> lock{own.mutex};
+      own.begin = begin;
+      own.end = end;
+      return true;
+    }
+  }
+};
+
+}  // namespace
+
+struct ThreadPool::Batch {
+  Scheduler scheduler;
+
+  // Jobs for this batch that are queued or running.
+  size_t pending;
+};
+
+ThreadPool::ThreadPool(size_t threads)
+    : m_size{threads ? threads
+                     : std::max(std::thread::hardware_concurrency(), 1u)} {}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_stop = true;
+  }
+  m_work.notify_all();
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallel_for(size_t tasks,
+                              const std::function<void(size_t)>& task) {
+  size_t threads{std::min(m_size, tasks)};
+  if (threads <= 1) {
+    for (size_t i = 0; i < tasks; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  Batch batch{{tasks, threads, task}, threads - 1};
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    while (m_workers.size() < m_size - 1) {
+      m_workers.emplace_back([this]() { run(); });
+    }
+    for (size_t i = 1; i < threads; i++) {
+      m_jobs.push_back({&batch, i});
+    }
+  }
+  m_work.notify_all();
+
+  batch.scheduler.run(0);
+
+  // Our share and every other share are done or running now, so jobs that
+  // haven't started have nothing left to do.
+  {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    for (auto it = m_jobs.begin(); it != m_jobs.end();) {
+      if (it->batch == &batch) {
+        it = m_jobs.erase(it);
+        batch.pending--;
+      } else {
+        it++;
+      }
+    }
+    m_done.wait(lock, [&]() { return batch.pending == 0; });
+  }
+  batch.scheduler.rethrow();
+}
+
+void ThreadPool::run() {
+  std::unique_lock<std::mutex> lock{m_mutex};
+  while (true) {
+    m_work.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+    if (m_stop) {
+      return;
+    }
+
+    Job job{m_jobs.front()};
+    m_jobs.pop_front();
+    lock.unlock();
+    job.batch->scheduler.run(job.share);
+    lock.lock();
+    if (--job.batch->pending == 0) {
+      m_done.notify_all();
+    }
+  }
+}
+
+}  // namespace libjsonpath
@@ -1,17 +1,30 @@
 #include "libjsonpath/path.hpp"
 
-#include <algorithm>      // std::min std::max
-#include <cmath>          // std::abs
-#include <cstdint>        // std::int64_t
-#include <limits>         // std::numeric_limits
-#include <string>         // std::string
-#include <unordered_map>  // std::unordered_map
-#include <variant>        // std::variant std::visit
-
+#include <algorithm>  // std::min std::max std::sort
+#include <atomic>     // std::atomic
+#include <cmath>      // std::abs
+#include <cstdint>    // std::int64_t
+#include <limits>     // std::numeric_limits
+#include <memory>     // std::shared_ptr std::make_shared
+#include <numeric>    // std::iota
+#include <optional>   // std::optional
+#include <string>     // std::string
+#include <utility>    // std::move
+#include <variant>    // std::variant std::visit
+
+#include "libjsonpath/containers.hpp"
+#include "libjsonpath/document.hpp"
+#include "libjsonpath/document_query.hpp"
 #include "libjsonpath/exceptions.hpp"
+#include "libjsonpath/filter.hpp"
+#include "libjsonpath/iregexp.hpp"
 #include "libjsonpath/jsonpath.hpp"
+#include "libjsonpath/kernels.hpp"
 #include "libjsonpath/node.hpp"
+#include "libjsonpath/pool.hpp"
 #include "libjsonpath/selectors.hpp"
+#include "libjsonpath/serialize.hpp"
+#include "libjsonpath/typed_array.hpp"
 #include "nanobind/nanobind.h"
 
 namespace nb = nanobind;
@@ -21,8 +34,6 @@ namespace libjsonpath {
 using namespace std::string_literals;
 using expression_rv = std::variant<JSONPathNodeList, nb::object>;
 
-// Convert negative indicies to their positive equivalents given
-// an "array" length.
 size_t normalized_index(size_t length, std::int64_t index, const Token& token) {
   if (index >= 0) {
     return static_cast<size_t>(index);
@@ -38,202 +49,409 @@ size_t normalized_index(size_t length, std::int64_t index, const Token& token) {
 
 // JSONPath expression result truthiness test.
 bool is_truthy(const expression_rv& rv) {
-  if (std::holds_alternative<JSONPathNodeList>(rv)) {
-    auto nodes = std::get<JSONPathNodeList>(rv);
-    return !nodes.empty();
+  if (auto nodes = std::get_if<JSONPathNodeList>(&rv)) {
+    return !nodes->empty();
   }
 
-  auto value{std::get<nb::object>(rv)};
-  return !(nb::isinstance<nb::bool_>(value) && !nb::cast<nb::bool_>(value));
+  return is_truthy(std::get<nb::object>(rv));
 }
 
-// Cast a python str to an std::string.
-std::string key_to_string(const nb::handle& key) {
+// Raise a TypeError if _key_ is not a Python str.
+void check_key(const nb::handle& key) {
   if (!nb::isinstance<nb::str>(key)) {
     auto repr = nb::repr(key);
     std::string what =
         "expected mapping with string keys, found "s + repr.c_str();
     throw nb::type_error(what.c_str());
   }
-
-  // We kept getting std::bad_cast when trying to use nb::cast<std::string>,
-  // but only in some cases on some os/py versions.
-  std::string rv{};
-  nb::try_cast<std::string>(key, rv);
-  return rv;  // XXX: empty string if cast fails
 }
 
-// Visit every object with _node.value_ at the root.
-void descend(const JSONPathNode& node, std::vector<JSONPathNode>& out_nodes) {
-  out_nodes.push_back(node);
-  if (nb::isinstance<nb::dict>(node.value)) {
-    auto obj{nb::cast<nb::dict>(node.value)};
-    for (auto item : obj) {
-      nb::object val = nb::cast<nb::object>(item.second);
-      location_t location{node.location};
-      location.push_back(key_to_string(item.first));
-      descend({val, location}, out_nodes);
+// Return the value of _name_ in _obj_, or an invalid object if _obj_ is not a
+// dict or doesn't have _name_.
+nb::object name_value(const nb::object& obj, const nb::str& name) {
+  if (PyDict_CheckExact(obj.ptr())) {
+    // One lookup, reusing the interned name's hash.
+    return dict_item(obj.ptr(), name.ptr());
+  } else if (nb::isinstance<nb::dict>(obj)) {
+    // Subclasses of dict might override __getitem__.
+    auto dict{nb::borrow<nb::dict>(obj)};
+    nb::str key{name};
+    if (dict.contains(key)) {
+      return dict[key];
     }
-  } else if (nb::isinstance<nb::list>(node.value)) {
-    auto obj{nb::cast<nb::list>(node.value)};
-    size_t index{0};
-    for (auto item : obj) {
-      nb::object val = nb::cast<nb::object>(item);
-      location_t location{node.location};
-      location.push_back(index);
-      descend({val, location}, out_nodes);
-      index++;
+  }
+  return {};
+}
+
+// Return the item in _obj_ selected by _selector_, or an invalid object if
+// _obj_ is not a list or the index is out of range. _index_ is set to the
+// normalized index.
+nb::object index_value(const nb::object& obj, const IndexSelector& selector,
+                       size_t& index) {
+  if (nb::isinstance<nb::list>(obj)) {
+    auto len{static_cast<size_t>(PyList_Size(obj.ptr()))};
+    index = normalized_index(len, selector.index, selector.token);
+    if (index < len) {
+      return list_item(obj.ptr(), static_cast<Py_ssize_t>(index));
     }
   }
+  return {};
 }
 
-// Return a list of values from a node list, or a single value if
-// the node list only has one item.
-nb::object values_or_singular(const JSONPathNodeList& nodes) {
-  if (nodes.size() == 1) {
-    return nodes[0].value;
+// Selectors and segments are generic over how they build child nodes. With
+// LocatedNodes, every node carries its location. With ValueNodes, a node is
+// just its value, so values-only queries never build locations.
+struct LocatedNodes {
+  using node_t = JSONPathNode;
+
+  static const nb::object& value(const node_t& node) { return node.value; }
+
+  static node_t root(nb::object& obj) { return {obj, {}}; }
+
+  static node_t child(const node_t& parent, nb::object& val,
+                      const nb::str& name) {
+    return parent.child(val, name);
   }
 
-  nb::list values{};
-  for (auto node : nodes) {
-    values.append(node.value);
+  static node_t child(const node_t& parent, nb::object& val, size_t index) {
+    return parent.child(val, index);
   }
 
-  return values;
-}
+  static node_t child(const node_t& parent, nb::object& val,
+                      const nb::handle& key) {
+    check_key(key);
+    return parent.child(val, nb::borrow<nb::str>(key));
+  }
+};
 
-class QueryContext {
-public:
-  QueryContext(nb::object root_, const function_extension_map& functions_,
-               const function_signature_map& signatures_, nb::object nothing_);
+struct ValueNodes {
+  using node_t = nb::object;
 
-  const nb::object root;
-  const function_extension_map& functions;
-  const function_signature_map& signatures;
-  const nb::object nothing;
-};
+  static const nb::object& value(const node_t& node) { return node; }
+
+  static node_t root(nb::object& obj) { return obj; }
 
-QueryContext::QueryContext(nb::object root_,
-                           const function_extension_map& functions_,
-                           const function_signature_map& signatures_,
-                           nb::object nothing_)
-    : root{root_},
-      functions{functions_},
-      signatures{signatures_},
-      nothing{nothing_} {}
-
-// Contextual objects a JSONPath filter will operate on.
-struct FilterContext {
-  const QueryContext& query;
-  nb::object current;
+  static node_t child(const node_t&, nb::object& val, const nb::str&) {
+    return val;
+  }
+
+  static node_t child(const node_t&, nb::object& val, size_t) { return val; }
+
+  static node_t child(const node_t&, nb::object& val, const nb::handle& key) {
+    check_key(key);
+    return val;
+  }
 };
 
-class ExpressionVisitor {
+// A preorder traversal of a node and all of its descendants. We keep our own
+// stack of partially visited containers instead of recursing, so deeply
+// nested data can't overflow the native stack, and only one node at a time
+// is materialized.
+template <typename Nodes>
+class Descendants {
 private:
-  const FilterContext& m_context;
+  using node_t = typename Nodes::node_t;
+
+  struct Frame {
+    node_t node;
+    bool is_dict;
+    Py_ssize_t position;
+  };
+
+  std::optional<node_t> m_start;
+  PooledVector<Frame> m_stack{};
 
 public:
-  ExpressionVisitor(const FilterContext& filter_context)
-      : m_context{filter_context} {}
+  explicit Descendants(node_t node) : m_start{std::move(node)} {}
+
+  // Return the next node in document order, or nothing if we've visited
+  // every descendant.
+  std::optional<node_t> next() {
+    if (m_start) {
+      std::optional<node_t> node{std::move(m_start)};
+      m_start.reset();
+      enter(*node);
+      return node;
+    }
 
-  ~ExpressionVisitor() = default;
+    while (!m_stack->empty()) {
+      auto node{next_child(m_stack->back())};
+      if (node) {
+        enter(*node);
+        return node;
+      }
+      m_stack->pop_back();
+    }
 
-  expression_rv operator()(const NullLiteral&) const { return nb::none(); }
+    return std::nullopt;
+  }
 
-  expression_rv operator()(const BooleanLiteral& expression) const {
-    return nb::bool_(expression.value);
+private:
+  void enter(const node_t& node) {
+    const nb::object& value{Nodes::value(node)};
+    if (nb::isinstance<nb::dict>(value)) {
+      m_stack->push_back({node, true, 0});
+    } else if (nb::isinstance<nb::list>(value)) {
+      m_stack->push_back({node, false, 0});
+    }
   }
 
-  expression_rv operator()(const IntegerLiteral& expression) const {
-    return nb::int_(expression.value);
+  std::optional<node_t> next_child(Frame& frame) {
+    PyObject* container{Nodes::value(frame.node).ptr()};
+    nb::ft_object_guard guard{container};
+    if (frame.is_dict) {
+      PyObject* key{nullptr};
+      PyObject* val{nullptr};
+      if (PyDict_Next(container, &frame.position, &key, &val)) {
+        nb::object val_{nb::borrow(val)};
+        return Nodes::child(frame.node, val_, nb::handle{key});
+      }
+    } else if (frame.position < PyList_Size(container)) {
+      nb::object val{nb::borrow(PyList_GetItem(container, frame.position))};
+      size_t index{static_cast<size_t>(frame.position++)};
+      return Nodes::child(frame.node, val, index);
+    }
+    return std::nullopt;
   }
+};
 
-  expression_rv operator()(const FloatLiteral& expression) const {
-    return nb::float_(expression.value);
+SliceBounds slice_bounds(const SliceSelector& selector, size_t size) {
+  std::int64_t step{selector.step.value_or(1)};
+  if (!size || step == 0) {
+    return {0, 0, 1};
   }
 
-  expression_rv operator()(const StringLiteral& expression) const {
-    return nb::str(expression.value.c_str());
+  std::int64_t length = static_cast<std::int64_t>(size);
+  std::int64_t start{0};
+  std::int64_t stop{length};
+
+  // Handle negative start values.
+  if (!selector.start) {
+    start = step < 0 ? length - 1 : 0;
+  } else if (selector.start.value() < 0) {
+    start = std::max(length + selector.start.value(), std::int64_t{0});
+  } else {
+    start = std::min(selector.start.value(), length - 1);
   }
 
-  expression_rv operator()(const Box<LogicalNotExpression>& expression) const {
-    return nb::bool_(!is_truthy(std::visit(*this, expression->right)));
+  // Handle negative stop values
+  if (!selector.stop) {
+    stop = step < 0 ? -1 : length;
+  } else if (selector.stop.value() < 0) {
+    stop = std::max(length + selector.stop.value(), std::int64_t{-1});
+  } else {
+    stop = std::min(selector.stop.value(), length);
   }
 
-  expression_rv operator()(const Box<InfixExpression>& expression) const {
-    // Unpack single value node list.
-    expression_rv left{std::visit(*this, expression->left)};
-    if (std::holds_alternative<JSONPathNodeList>(left)) {
-      auto left_ = std::get<JSONPathNodeList>(left);
-      if (left_.size() == 1) {
-        left = left_[0].value;
+  return {start, stop, step};
+}
+
+// Return a list of values from a node list, or a single value if
+// the node list only has one item.
+nb::object values_or_singular(const JSONPathNodeList& nodes) {
+  if (nodes.size() == 1) {
+    return nodes[0].value;
+  }
+
+  nb::list values{};
+  for (auto node : nodes) {
+    values.append(node.value);
+  }
+
+  return values;
+}
+
+SelectorNames::SelectorNames(const segments_t& segments) {
+  for_each_query(segments, [this](const segments_t& query) {
+    for (const auto& segment : query) {
+      for (const auto& selector : std::visit(
+               [](const auto& segment_) -> const auto& {
+                 return segment_.selectors;
+               },
+               segment)) {
+        if (auto name = std::get_if<NameSelector>(&selector)) {
+          PyObject* str{PyUnicode_DecodeUTF8(
+              name->name.data(), static_cast<Py_ssize_t>(name->name.size()),
+              "surrogatepass")};
+          if (!str) {
+            throw nb::python_error();
+          }
+          PyUnicode_InternInPlace(&str);
+          m_names.emplace(name, nb::steal<nb::str>(str));
+        }
       }
     }
+  });
+}
+
+QueryContext::QueryContext(nb::object root_, nb::object nothing_,
+                           const FilterPrograms& filters_,
+                           const SelectorNames& names_)
+    : root{root_}, nothing{nothing_}, filters{filters_}, names{names_} {}
+
+template <typename Nodes>
+std::vector<typename Nodes::node_t> resolve(const QueryContext& q_ctx,
+                                            const segments_t& segments,
+                                            nb::object start);
+
+JSONPathNodeList resolve_first(const QueryContext& q_ctx,
+                               const segments_t& segments, nb::object start,
+                               size_t limit);
 
-    // Unpack single value node list.
-    expression_rv right{std::visit(*this, expression->right)};
-    if (std::holds_alternative<JSONPathNodeList>(right)) {
-      auto right_ = std::get<JSONPathNodeList>(right);
-      if (right_.size() == 1) {
-        right = right_[0].value;
+template <typename Nodes>
+std::optional<typename Nodes::node_t> resolve_singular(
+    const QueryContext& q_ctx, const segments_t& segments, nb::object start);
+
+// Runs a compiled filter program against candidate nodes. One machine is
+// used for all of a filter selector's candidates, so its stack is only
+// allocated once.
+class FilterMachine {
+private:
+  const QueryContext& m_context;
+  const FilterProgram& m_program;
+  PooledVector<expression_rv> m_stack{};
+
+public:
+  FilterMachine(const QueryContext& q_ctx, const FilterSelector& selector)
+      : m_context{q_ctx}, m_program{q_ctx.filters.get(selector)} {
+    m_stack->reserve(m_program.stack_size);
+  }
+
+  // Return true if the filter selects _current_.
+  bool test(nb::handle current) {
+    m_stack->clear();
+    const auto& code{m_program.code};
+    for (size_t ip = 0; ip < code.size(); ip++) {
+      const auto& instruction{code[ip]};
+      switch (instruction.opcode) {
+        case Opcode::push:
+          m_stack->emplace_back(m_program.literals[instruction.operand]);
+          break;
+        case Opcode::relative_query:
+          m_stack->emplace_back(query(instruction.operand, current));
+          break;
+        case Opcode::root_query:
+          m_stack->emplace_back(root_query(instruction.operand));
+          break;
+        case Opcode::call:
+          call(m_program.calls[instruction.operand]);
+          break;
+        case Opcode::unpack:
+          unpack(m_stack->back());
+          break;
+        case Opcode::truthy:
+          m_stack->back() = nb::bool_(is_truthy(m_stack->back()));
+          break;
+        case Opcode::logical_not:
+          m_stack->back() = nb::bool_(!is_truthy(m_stack->back()));
+          break;
+        case Opcode::jump_if_false:
+          if (!is_truthy(m_stack->back())) {
+            m_stack->back() = nb::bool_(false);
+            ip += instruction.operand;
+          } else {
+            m_stack->pop_back();
+          }
+          break;
+        case Opcode::jump_if_true:
+          if (is_truthy(m_stack->back())) {
+            m_stack->back() = nb::bool_(true);
+            ip += instruction.operand;
+          } else {
+            m_stack->pop_back();
+          }
+          break;
+        case Opcode::compare: {
+          auto op{static_cast<BinaryOperator>(instruction.operand)};
+          const auto& stack{*m_stack};
+          bool rv{compare(stack[stack.size() - 2], op, stack.back())};
+          m_stack->pop_back();
+          m_stack->back() = nb::bool_(rv);
+          break;
+        }
       }
     }
+    return is_truthy(m_stack->back());
+  }
 
-    if (expression->op == BinaryOperator::logical_and) {
-      return nb::bool_(is_truthy(left) && is_truthy(right));
+private:
+  JSONPathNodeList query(size_t index, nb::handle obj) const {
+    const auto& query{m_program.queries[index]};
+    if (query.singular) {
+      JSONPathNodeList nodes{};
+      if (auto node{resolve_singular<LocatedNodes>(m_context, *query.segments,
+                                                   nb::borrow(obj))}) {
+        nodes.push_back(std::move(*node));
+      }
+      return nodes;
     }
-
-    if (expression->op == BinaryOperator::logical_or) {
-      return nb::bool_(is_truthy(left) || is_truthy(right));
+    if (query.limit) {
+      return resolve_first(m_context, *query.segments, nb::borrow(obj),
+                           query.limit);
     }
-
-    return nb::bool_(compare(left, expression->op, right));
+    return resolve<LocatedNodes>(m_context, *query.segments, nb::borrow(obj));
   }
 
-  expression_rv operator()(const Box<RelativeQuery>& expression) const {
-    return query_(expression->query, m_context.current,
-                  m_context.query.functions, m_context.query.signatures,
-                  m_context.query.nothing);
+  // Root queries don't depend on the current node, so we evaluate each one
+  // once per top-level query.
+  const JSONPathNodeList& root_query(size_t index) const {
+    auto& memo{m_context.root_queries};
+    const FilterQuery* key{&m_program.queries[index]};
+    auto it{memo.find(key)};
+    if (it == memo.end()) {
+      it = memo.emplace(key, query(index, m_context.root)).first;
+    }
+    return it->second;
   }
 
-  expression_rv operator()(const Box<RootQuery>& expression) const {
-    return query_(expression->query, m_context.query.root,
-                  m_context.query.functions, m_context.query.signatures,
-                  m_context.query.nothing);
+  // Unpack single value node list.
+  static void unpack(expression_rv& rv) {
+    if (auto nodes = std::get_if<JSONPathNodeList>(&rv)) {
+      if (nodes->size() == 1) {
+        nb::object value{(*nodes)[0].value};
+        rv = std::move(value);
+      }
+    }
   }
 
-  expression_rv operator()(const Box<FunctionCall>& expression) const {
-    auto name{std::string{expression->name}};
-    auto it{m_context.query.functions.find(name)};
-    if (it == m_context.query.functions.end()) {
+  // Pop _call_'s arguments and push its return value.
+  void call(const BoundCall& call) {
+    const FunctionCall& expression{*call.expression};
+    if (!call.func.is_valid()) {
       throw NameError(
-          "undefined filter function '"s + std::string(expression->name) + "'"s,
-          expression->token);
+          "undefined filter function '"s + std::string(expression.name) + "'"s,
+          expression.token);
     }
 
-    nb::callable func = it->second;
-
-    auto sig_it{m_context.query.signatures.find(name)};
-    if (sig_it == m_context.query.signatures.end()) {
+    if (!call.signature) {
       throw NameError("missing types for filter function '"s +
-                          std::string(expression->name) + "'"s,
-                      expression->token);
+                          std::string(expression.name) + "'"s,
+                      expression.token);
+    }
+    const FunctionExtensionTypes& func_sig = *call.signature;
+
+    const size_t argc{expression.args.size()};
+    const size_t first{m_stack->size() - argc};
+
+    if (call.native != NativeFunction::none) {
+      nb::object rv{call_native(call, first)};
+      m_stack->erase(m_stack->begin() + first, m_stack->end());
+      m_stack->emplace_back(std::move(rv));
+      return;
     }
-    FunctionExtensionTypes func_sig = sig_it->second;
 
     nb::list args{};
-    size_t index = 0;
 
-    for (auto arg : expression->args) {
-      expression_rv arg_rv{std::visit(*this, arg)};
+    for (size_t index = 0; index < argc; index++) {
+      const expression_rv& arg_rv{(*m_stack)[first + index]};
       if (std::holds_alternative<JSONPathNodeList>(arg_rv)) {
-        auto nodes{std::get<JSONPathNodeList>(arg_rv)};
+        const auto& nodes{std::get<JSONPathNodeList>(arg_rv)};
         // Is the parameter expected a node list of values?
         // Assumes the function call has already been validated and has
         // the correct number of arguments.
         if (func_sig.args[index] != ExpressionType::nodes) {
           if (nodes.empty()) {
-            args.append(m_context.query.nothing);
+            args.append(m_context.nothing);
           } else if (nodes.size() == 1) {
             args.append(nodes[0].value);
           } else {
@@ -245,19 +463,98 @@ public:
       } else {
         args.append(std::get<nb::object>(arg_rv));
       }
-
-      index++;
     }
 
-    auto rv{func(*args)};
+    m_stack->erase(m_stack->begin() + first, m_stack->end());
+
+    auto rv{call.func(*args)};
     if (func_sig.res == ExpressionType::nodes) {
-      // TODO: catch exception.
-      return nb::cast<JSONPathNodeList>(rv);
+      try {
+        m_stack->emplace_back(nb::cast<JSONPathNodeList>(rv));
+      } catch (const nb::cast_error&) {
+        throw TypeError("filter function '"s + std::string(expression.name) +
+                            "' must return a list of nodes"s,
+                        expression.token);
+      }
+    } else {
+      m_stack->emplace_back(std::move(rv));
     }
-    return rv;
   }
 
-private:
+  // The result of calling the built-in Python implementation of _call_ with
+  // arguments from the stack starting at _first_, without calling into
+  // Python.
+  nb::object call_native(const BoundCall& call, size_t first) const {
+    const expression_rv& arg{(*m_stack)[first]};
+    const auto* nodes{std::get_if<JSONPathNodeList>(&arg)};
+
+    switch (call.native) {
+      case NativeFunction::count:
+        if (nodes) {
+          return nb::int_(nodes->size());
+        }
+        return nb::int_(nb::len(std::get<nb::object>(arg)));
+      case NativeFunction::value:
+        if (nodes && nodes->size() == 1) {
+          return (*nodes)[0].value;
+        }
+        return m_context.nothing;
+      case NativeFunction::length:
+        return length(value_argument(arg));
+      case NativeFunction::match:
+      case NativeFunction::search:
+        return nb::bool_(matches(call, value_argument(arg),
+                                 value_argument((*m_stack)[first + 1])));
+      default:
+        return m_context.nothing;
+    }
+  }
+
+  // A function argument for a parameter of type ValueType.
+  nb::object value_argument(const expression_rv& arg) const {
+    if (auto nodes = std::get_if<JSONPathNodeList>(&arg)) {
+      if (nodes->empty()) {
+        return m_context.nothing;
+      }
+      if (nodes->size() == 1) {
+        return (*nodes)[0].value;
+      }
+      return nb::cast(*nodes);
+    }
+    return std::get<nb::object>(arg);
+  }
+
+  // Native `match` and `search`. Patterns that are not strings or not valid
+  // I-Regexps never match.
+  static bool matches(const BoundCall& call, const nb::object& string,
+                      const nb::object& pattern) {
+    if (!nb::isinstance<nb::str>(string)) {
+      return false;
+    }
+
+    auto regexp{call.pattern ? *call.pattern : IRegexp::cached(pattern)};
+
+    if (!regexp) {
+      return false;
+    }
+
+    return call.native == NativeFunction::match ? regexp->match(string)
+                                                : regexp->search(string);
+  }
+
+  // len(obj), or _nothing_ if _obj_ does not have a length.
+  nb::object length(const nb::object& obj) const {
+    Py_ssize_t size{PyObject_Size(obj.ptr())};
+    if (size < 0) {
+      if (!PyErr_ExceptionMatches(PyExc_TypeError)) {
+        throw nb::python_error();
+      }
+      PyErr_Clear();
+      return m_context.nothing;
+    }
+    return nb::int_(size);
+  }
+
   bool compare(const expression_rv& left, BinaryOperator op,
                const expression_rv& right) const {
     switch (op) {
@@ -266,18 +563,28 @@ private:
       case BinaryOperator::ne:
         return !equals(left, right);
       case BinaryOperator::lt:
-        return less_than(left, right);
       case BinaryOperator::gt:
-        return less_than(right, left);
+        return both_objects(left, right) &&
+               compare_objects(std::get<nb::object>(left), op,
+                               std::get<nb::object>(right));
       case BinaryOperator::ge:
-        return less_than(right, left) || equals(left, right);
       case BinaryOperator::le:
-        return less_than(left, right) || equals(left, right);
+        if (both_objects(left, right)) {
+          return compare_objects(std::get<nb::object>(left), op,
+                                 std::get<nb::object>(right));
+        }
+        return equals(left, right);
       default:
         return false;
     }
   }
 
+  static bool both_objects(const expression_rv& left,
+                           const expression_rv& right) {
+    return std::holds_alternative<nb::object>(left) &&
+           std::holds_alternative<nb::object>(right);
+  }
+
   bool equals(const expression_rv& left_, const expression_rv& right_) const {
     if (std::holds_alternative<JSONPathNodeList>(left_)) {
       return node_list_equals(std::get<JSONPathNodeList>(left_), right_);
@@ -288,32 +595,31 @@ private:
     }
 
     // Both left and right are py objects.
-    nb::object left{std::get<nb::object>(left_)};
-    nb::object right{std::get<nb::object>(right_)};
-    return left.equal(right);
+    return equal_objects(std::get<nb::object>(left_),
+                         std::get<nb::object>(right_));
   }
 
   bool node_list_equals(const JSONPathNodeList& left,
                         const expression_rv& right_) const {
     if (std::holds_alternative<nb::object>(right_)) {
-      nb::object right{std::get<nb::object>(right_)};
+      const nb::object& right{std::get<nb::object>(right_)};
 
       // left is an empty node list and right is NOTHING.
       if (left.empty()) {
-        return right.equal(m_context.query.nothing);
+        return equal_objects(right, m_context.nothing);
       }
 
       // left is a single element node list, compare the node's value to
       // right.
       if (left.size() == 1) {
-        return left[0].value.equal(right);
+        return equal_objects(left[0].value, right);
       }
 
       return false;
     }
 
     // left and right are node lists.
-    JSONPathNodeList right{std::get<JSONPathNodeList>(right_)};
+    const auto& right{std::get<JSONPathNodeList>(right_)};
 
     // Are both lists are empty?
     if (left.empty() && right.empty()) {
@@ -322,306 +628,1291 @@ private:
 
     // Do both lists have a single node?
     if (left.size() == 1 && right.size() == 1) {
-      return left[0].value.equal(right[0].value);
+      return equal_objects(left[0].value, right[0].value);
     }
 
     return false;
   }
+};
 
-  bool less_than(const expression_rv& left_,
-                 const expression_rv& right_) const {
-    if (std::holds_alternative<JSONPathNodeList>(left_) ||
-        std::holds_alternative<JSONPathNodeList>(right_)) {
-      return false;
+bool test_filter(const QueryContext& q_ctx, const FilterSelector& selector,
+                 nb::handle current) {
+  FilterMachine machine{q_ctx, selector};
+  return machine.test(current);
+}
+
+// Return the items of _list_ selected by _comparison_, or nothing if _list_
+// has items a ComparisonColumn can't hold. The caller holds a critical
+// section on _list_, and nothing here calls back into Python.
+static std::optional<bitmap_t> compare_list(
+    PyObject* list, const LiteralComparison& comparison) {
+  ComparisonColumn column{};
+  Py_ssize_t size{PyList_Size(list)};
+  for (Py_ssize_t i = 0; i < size; i++) {
+    PyObject* item{PyList_GetItem(list, i)};
+    bool pushed{false};
+    if (PyLong_CheckExact(item)) {
+      int overflow{0};
+      long long value{PyLong_AsLongLongAndOverflow(item, &overflow)};
+      if (value == -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+      } else {
+        pushed = !overflow && column.push_integer(value);
+      }
+    } else if (PyFloat_CheckExact(item)) {
+      pushed = column.push_real(PyFloat_AsDouble(item));
+    } else if (PyUnicode_CheckExact(item) &&
+               static_cast<size_t>(PyUnicode_GetLength(item)) <=
+                   ComparisonColumn::short_string_size) {
+      Py_ssize_t length{0};
+      const char* data{PyUnicode_AsUTF8AndSize(item, &length)};
+      if (!data) {
+        PyErr_Clear();
+      } else {
+        pushed = column.push_string({data, static_cast<size_t>(length)});
+      }
     }
 
-    nb::object left{std::get<nb::object>(left_)};
-    nb::object right{std::get<nb::object>(right_)};
+    if (!pushed) {
+      return std::nullopt;
+    }
+  }
+  return column.compare(comparison.op, comparison.literal);
+}
 
-    if (nb::isinstance<nb::bool_>(left) || nb::isinstance<nb::bool_>(right)) {
-      return false;
+template <typename Nodes>
+class SelectorVisitor {
+private:
+  using node_t = typename Nodes::node_t;
+
+  const QueryContext& m_query_context;
+  const node_t& m_node;
+  const nb::object& m_value;
+  std::vector<node_t>* m_out_nodes;
+
+public:
+  SelectorVisitor(const QueryContext& q_ctx, const node_t& node,
+                  std::vector<node_t>* out_nodes)
+      : m_query_context{q_ctx},
+        m_node{node},
+        m_value{Nodes::value(node)},
+        m_out_nodes{out_nodes} {}
+
+  ~SelectorVisitor() = default;
+
+  void operator()(const NameSelector& selector) {
+    const nb::str& name{m_query_context.names.get(selector)};
+    if (nb::object val{name_value(m_value, name)}; val.is_valid()) {
+      m_out_nodes->push_back(Nodes::child(m_node, val, name));
     }
+  }
 
-    if (nb::isinstance<nb::str>(left) && nb::isinstance<nb::str>(right)) {
-      return left < right;
+  void operator()(const IndexSelector& selector) {
+    size_t index{0};
+    if (nb::object val{index_value(m_value, selector, index)};
+        val.is_valid()) {
+      m_out_nodes->push_back(Nodes::child(m_node, val, index));
     }
+  }
 
-    if (nb::isinstance<nb::int_>(left) && nb::isinstance<nb::int_>(right)) {
-      return left < right;
+  void operator()(const WildSelector&) {
+    nb::ft_object_guard guard{m_value};
+    if (nb::isinstance<nb::dict>(m_value)) {
+      Py_ssize_t position{0};
+      PyObject* key{nullptr};
+      PyObject* val{nullptr};
+      while (PyDict_Next(m_value.ptr(), &position, &key, &val)) {
+        nb::object val_{nb::borrow(val)};
+        m_out_nodes->push_back(Nodes::child(m_node, val_, nb::handle{key}));
+      }
+    } else if (nb::isinstance<nb::list>(m_value)) {
+      for (Py_ssize_t i = 0; i < PyList_Size(m_value.ptr()); i++) {
+        nb::object val{nb::borrow(PyList_GetItem(m_value.ptr(), i))};
+        m_out_nodes->push_back(
+            Nodes::child(m_node, val, static_cast<size_t>(i)));
+      }
     }
+  }
+
+  void operator()(const SliceSelector& selector) {
+    nb::ft_object_guard guard{m_value};
+    if (nb::isinstance<nb::list>(m_value)) {
+      auto slice{slice_bounds(
+          selector, static_cast<size_t>(PyList_Size(m_value.ptr())))};
+      for (auto i{slice.start}; slice.in_range(i); i += slice.step) {
+        nb::object val{nb::borrow(PyList_GetItem(m_value.ptr(), i))};
+        m_out_nodes->push_back(
+            Nodes::child(m_node, val, static_cast<size_t>(i)));
+      }
+    }
+  }
 
-    if (nb::isinstance<nb::int_>(left) && nb::isinstance<nb::float_>(right)) {
-      return left < right;
+  // Candidates are held by a strong reference while they are tested, as the
+  // filter might call into Python and remove them from the container.
+  void operator()(const Box<FilterSelector>& selector) {
+    nb::ft_object_guard guard{m_value};
+    if (nb::isinstance<nb::dict>(m_value)) {
+      FilterMachine machine{m_query_context, *selector};
+      Py_ssize_t position{0};
+      PyObject* key{nullptr};
+      PyObject* val{nullptr};
+      while (PyDict_Next(m_value.ptr(), &position, &key, &val)) {
+        nb::object key_{nb::borrow(key)};
+        nb::object val_{nb::borrow(val)};
+        if (machine.test(val_.ptr())) {
+          m_out_nodes->push_back(Nodes::child(m_node, val_, key_));
+        }
+      }
+    } else if (nb::isinstance<nb::list>(m_value)) {
+      if (columnar(*selector)) {
+        return;
+      }
+      FilterMachine machine{m_query_context, *selector};
+      for (Py_ssize_t i = 0; i < PyList_Size(m_value.ptr()); i++) {
+        nb::object val{nb::borrow(PyList_GetItem(m_value.ptr(), i))};
+        if (machine.test(val.ptr())) {
+          m_out_nodes->push_back(
+              Nodes::child(m_node, val, static_cast<size_t>(i)));
+        }
+      }
     }
+  }
 
-    if (nb::isinstance<nb::float_>(left) && nb::isinstance<nb::float_>(right)) {
-      return left < right;
+private:
+  // Filter an exact list with a comparison kernel, if _selector_ compares
+  // each item with a literal. Return false if the list must be filtered one
+  // item at a time.
+  bool columnar(const FilterSelector& selector) {
+    const auto& comparison{
+        m_query_context.filters.get(selector).literal_comparison};
+    if (!comparison || !PyList_CheckExact(m_value.ptr()) ||
+        static_cast<size_t>(PyList_Size(m_value.ptr())) < min_column_size) {
+      return false;
     }
 
-    if (nb::isinstance<nb::float_>(left) && nb::isinstance<nb::int_>(right)) {
-      return left < right;
+    auto selected{compare_list(m_value.ptr(), *comparison)};
+    if (!selected) {
+      return false;
     }
 
-    return false;
+    for_each_selected(*selected, [&](size_t i) {
+      nb::object val{list_item(m_value.ptr(), static_cast<Py_ssize_t>(i))};
+      if (val.is_valid()) {
+        m_out_nodes->push_back(Nodes::child(m_node, val, i));
+      }
+    });
+    return true;
   }
 };
 
-class SelectorVisitor {
+template <typename Nodes>
+class SegmentVisitor {
 private:
-  const QueryContext& m_query_context;
-  const JSONPathNode& m_node;
-  std::vector<JSONPathNode>* m_out_nodes;
+  using node_t = typename Nodes::node_t;
+
+  const QueryContext& m_context;
+  const std::vector<node_t>& m_nodes;
+  std::vector<node_t>* m_out_nodes;
 
 public:
-  SelectorVisitor(const QueryContext& q_ctx, const JSONPathNode& node,
-                  std::vector<JSONPathNode>* out_nodes)
-      : m_query_context{q_ctx}, m_node{node}, m_out_nodes{out_nodes} {}
+  SegmentVisitor(const QueryContext& q_ctx, const std::vector<node_t>& nodes,
+                 std::vector<node_t>* out_nodes)
+      : m_context{q_ctx}, m_nodes{nodes}, m_out_nodes{out_nodes} {}
 
-  ~SelectorVisitor() = default;
+  ~SegmentVisitor() = default;
 
-  void operator()(const NameSelector& selector) {
-    if (nb::isinstance<nb::dict>(m_node.value)) {
-      auto obj{nb::cast<nb::dict>(m_node.value)};
-      nb::str name{selector.name.c_str()};
-      if (obj.contains(name)) {
-        nb::object val{obj[name]};
-        location_t location{m_node.location};
-        location.push_back(selector.name);
-        m_out_nodes->push_back(JSONPathNode{val, location});
+  void operator()(const Segment& segment) {
+    for (const auto& node : m_nodes) {
+      SelectorVisitor<Nodes> visitor{m_context, node, m_out_nodes};
+      for (const auto& selector : segment.selectors) {
+        std::visit(visitor, selector);
       }
     }
   }
 
-  void operator()(const IndexSelector& selector) {
-    if (nb::isinstance<nb::list>(m_node.value)) {
-      auto obj{nb::cast<nb::list>(m_node.value)};
-      size_t len{nb::len(obj)};
-      auto index{normalized_index(len, selector.index, selector.token)};
-      if (index < len) {
-        nb::object val{obj[index]};
-        location_t location{m_node.location};
-        location.push_back(index);
-        m_out_nodes->push_back(JSONPathNode{val, location});
+  void operator()(const RecursiveSegment& segment) {
+    // Select from each descendant as we visit it, rather than collecting
+    // all descendants first.
+    for (const auto& node : m_nodes) {
+      Descendants<Nodes> descendants{node};
+      while (auto descendant = descendants.next()) {
+        SelectorVisitor<Nodes> visitor{m_context, *descendant, m_out_nodes};
+        for (const auto& selector : segment.selectors) {
+          std::visit(visitor, selector);
+        }
       }
     }
   }
+};
 
-  void operator()(const WildSelector&) {
-    if (nb::isinstance<nb::dict>(m_node.value)) {
-      auto obj{nb::cast<nb::dict>(m_node.value)};
-      for (auto item : obj) {
-        nb::object val = nb::cast<nb::object>(item.second);
-        location_t location{m_node.location};
-        location.push_back(key_to_string(item.first));
-        m_out_nodes->push_back(JSONPathNode{val, location});
+const selector_list_t& segment_selectors(
+    const std::variant<Segment, RecursiveSegment>& segment) {
+  return std::visit(
+      [](const auto& segment_) -> const selector_list_t& {
+        return segment_.selectors;
+      },
+      segment);
+}
+
+// Evaluates queries with more than one descendant segment in a single
+// depth-first pass over the data, instead of descending again from every node
+// selected by an earlier descendant segment.
+//
+// Segment _i_ is a state. A node "arrives" at state _i + 1_ when segment _i_
+// selects it. Arrivals at recursive segments stay active for all of a node's
+// descendants. Every arrival records the steps that led to it, so the same
+// node can arrive more than once, just like segment by segment evaluation,
+// and results are sorted back into the order that evaluation would produce.
+//
+// Only name, index and wildcard selectors are supported. See `supports`.
+template <typename Nodes>
+class SegmentAutomaton {
+private:
+  using node_t = typename Nodes::node_t;
+  static constexpr size_t no_step{std::numeric_limits<size_t>::max()};
+
+  // One segment's contribution to a result: the preorder id of the node
+  // selectors were applied to, the selector's index and the selected child's
+  // position. _parent_ is the step taken by the previous segment.
+  struct Step {
+    size_t parent;
+    size_t node;
+    size_t selector;
+    size_t position;
+  };
+
+  // A node selected by segment _state - 1_, or the root at state 0.
+  struct Arrival {
+    size_t state;
+    size_t step;
+  };
+
+  // A partially visited dict or list, and the segments to apply to its
+  // children, grouped by segment.
+  struct Frame {
+    node_t node;
+    size_t id;
+    std::vector<Arrival> applications;
+    std::vector<size_t> groups;
+    size_t descending;
+    bool is_dict;
+    size_t length;
+    Py_ssize_t position;
+    size_t index;
+  };
+
+  const segments_t& m_segments;
+  const SelectorNames& m_names;
+
+  std::vector<Step> m_steps{};
+  std::vector<Frame> m_stack{};
+
+  // Arrivals at recursive segments from the current node and its ancestors.
+  std::vector<Arrival> m_descending{};
+
+  // Arrivals at the next node to enter.
+  std::vector<Arrival> m_arrivals{};
+
+  size_t m_next_id{0};
+  std::vector<node_t> m_out_nodes{};
+  std::vector<size_t> m_out_steps{};
+
+public:
+  SegmentAutomaton(const segments_t& segments, const SelectorNames& names)
+      : m_segments{segments}, m_names{names} {}
+
+  // Return true if _segments_ would benefit from, and can be evaluated by,
+  // a segment automaton.
+  static bool supports(const segments_t& segments) {
+    size_t recursive{0};
+    for (const auto& segment : segments) {
+      if (std::holds_alternative<RecursiveSegment>(segment)) {
+        recursive++;
       }
-    } else if (nb::isinstance<nb::list>(m_node.value)) {
-      auto obj{nb::cast<nb::list>(m_node.value)};
-      size_t index{0};
-      for (auto item : obj) {
-        nb::object val = nb::cast<nb::object>(item);
-        location_t location{m_node.location};
-        location.push_back(index);
-        m_out_nodes->push_back(JSONPathNode{val, location});
-        index++;
+
+      for (const auto& selector : segment_selectors(segment)) {
+        if (!std::holds_alternative<NameSelector>(selector) &&
+            !std::holds_alternative<IndexSelector>(selector) &&
+            !std::holds_alternative<WildSelector>(selector)) {
+          return false;
+        }
       }
     }
+    return recursive > 1;
   }
 
-  void operator()(const SliceSelector& selector) {
-    if (nb::isinstance<nb::list>(m_node.value)) {
-      auto obj{nb::cast<nb::list>(m_node.value)};
-      for (auto i : slice_indicies(selector, obj.size())) {
-        auto item{obj[i]};
-        nb::object val = nb::cast<nb::object>(item);
-        auto norm_index{normalized_index(nb::len(obj), i, selector.token)};
-        location_t location{m_node.location};
-        location.push_back(norm_index);
-        m_out_nodes->push_back(JSONPathNode{val, location});
+  std::vector<node_t> run(node_t root) {
+    m_arrivals.push_back({0, no_step});
+    enter(std::move(root));
+    while (!m_stack.empty()) {
+      if (!next_child(m_stack.back())) {
+        m_descending.resize(m_stack.back().descending);
+        m_stack.pop_back();
       }
     }
+    return sorted();
   }
 
-  void operator()(const Box<FilterSelector>& selector) {
-    if (nb::isinstance<nb::dict>(m_node.value)) {
-      auto obj{nb::cast<nb::dict>(m_node.value)};
-      for (auto item : obj) {
-        nb::object val = nb::cast<nb::object>(item.second);
-        FilterContext filter_context{m_query_context, val};
-        ExpressionVisitor visitor{filter_context};
-
-        if (is_truthy(std::visit(visitor, selector->expression))) {
-          location_t location{m_node.location};
-          location.push_back(key_to_string(item.first));
-          m_out_nodes->push_back({val, location});
+private:
+  // Visit _node_, given arrivals in _m_arrivals_.
+  void enter(node_t node) {
+    size_t id{m_next_id++};
+    size_t descending{m_descending.size()};
+    std::vector<Arrival> applications{};
+
+    for (const auto& arrival : m_arrivals) {
+      if (arrival.state == m_segments.size()) {
+        m_out_nodes.push_back(node);
+        m_out_steps.push_back(arrival.step);
+      } else if (std::holds_alternative<RecursiveSegment>(
+                     m_segments[arrival.state])) {
+        m_descending.push_back(arrival);
+      } else {
+        applications.push_back(arrival);
+      }
+    }
+    m_arrivals.clear();
+
+    const nb::object& value{Nodes::value(node)};
+    bool is_dict{nb::isinstance<nb::dict>(value)};
+    applications.insert(applications.end(), m_descending.begin(),
+                        m_descending.end());
+
+    if (applications.empty() || !(is_dict || nb::isinstance<nb::list>(value))) {
+      m_descending.resize(descending);
+      return;
+    }
+
+    std::stable_sort(
+        applications.begin(), applications.end(),
+        [](const Arrival& a, const Arrival& b) { return a.state < b.state; });
+
+    std::vector<size_t> groups{0};
+    for (size_t i = 1; i < applications.size(); i++) {
+      if (applications[i].state != applications[i - 1].state) {
+        groups.push_back(i);
+      }
+    }
+    groups.push_back(applications.size());
+
+    size_t length{is_dict ? 0 : static_cast<size_t>(PyList_Size(value.ptr()))};
+    m_stack.push_back({std::move(node), id, std::move(applications),
+                       std::move(groups), descending, is_dict, length, 0, 0});
+  }
+
+  // Enter the next child of _frame_ that is selected or needs visiting.
+  // Return false if there are no more children.
+  bool next_child(Frame& frame) {
+    PyObject* container{Nodes::value(frame.node).ptr()};
+    nb::ft_object_guard guard{container};
+    while (true) {
+      PyObject* key{nullptr};
+      PyObject* val{nullptr};
+      if (frame.is_dict) {
+        if (!PyDict_Next(container, &frame.position, &key, &val)) {
+          return false;
+        }
+      } else {
+        if (frame.position >= PyList_Size(container)) {
+          return false;
         }
+        val = PyList_GetItem(container, frame.position++);
       }
-    } else if (nb::isinstance<nb::list>(m_node.value)) {
-      auto obj{nb::cast<nb::list>(m_node.value)};
-      size_t index{0};
-      for (auto item : obj) {
-        nb::object val = nb::cast<nb::object>(item);
-        FilterContext filter_context{m_query_context, val};
-        ExpressionVisitor visitor{filter_context};
-
-        if (is_truthy(std::visit(visitor, selector->expression))) {
-          location_t location{m_node.location};
-          location.push_back(index);
-          m_out_nodes->push_back({val, location});
+
+      size_t index{frame.index++};
+      select(frame, key, index);
+
+      // Descendant segments need to see every node below this one, selected
+      // or not.
+      if (m_arrivals.empty() && m_descending.empty()) {
+        continue;
+      }
+
+      nb::object val_{nb::borrow(val)};
+      enter(frame.is_dict ? Nodes::child(frame.node, val_, nb::handle{key})
+                          : Nodes::child(frame.node, val_, index));
+      return true;
+    }
+  }
+
+  // Apply the segments in _frame_ to the child at _key_ or _index_.
+  void select(const Frame& frame, PyObject* key, size_t index) {
+    for (size_t g = 0; g + 1 < frame.groups.size(); g++) {
+      auto begin{frame.applications.begin() + frame.groups[g]};
+      auto end{frame.applications.begin() + frame.groups[g + 1]};
+      size_t segment{begin->state};
+      const auto& selectors{segment_selectors(m_segments[segment])};
+
+      for (size_t i = 0; i < selectors.size(); i++) {
+        if (!matches(frame, segment, i, key, index)) {
+          continue;
         }
 
-        index++;
+        for (auto it{begin}; it != end; it++) {
+          m_steps.push_back({it->step, frame.id, i, index});
+          m_arrivals.push_back({segment + 1, m_steps.size() - 1});
+        }
       }
     }
   }
 
-private:
-  std::vector<int64_t> slice_indicies(const SliceSelector& selector,
-                                      size_t size) {
-    if (!size) {
-      return {};
+  bool matches(const Frame& frame, size_t segment, size_t selector,
+               PyObject* key, size_t index) const {
+    const auto& selector_{segment_selectors(m_segments[segment])[selector]};
+    if (auto name_ = std::get_if<NameSelector>(&selector_)) {
+      if (!frame.is_dict || !PyUnicode_Check(key)) {
+        return false;
+      }
+      PyObject* name{m_names.get(*name_).ptr()};
+      return key == name || PyUnicode_Compare(key, name) == 0;
+    }
+
+    if (auto index_ = std::get_if<IndexSelector>(&selector_)) {
+      return !frame.is_dict &&
+             normalized_index(frame.length, index_->index, index_->token) ==
+                 index;
     }
 
-    std::int64_t length = static_cast<std::int64_t>(size);
-    std::int64_t start{0};
-    std::int64_t stop{length};
-    std::int64_t step{selector.step.value_or(1)};
+    return std::holds_alternative<WildSelector>(selector_);
+  }
 
-    if (step == 0) {
-      return {};
+  // Results ordered by the steps that produced them.
+  std::vector<node_t> sorted() {
+    const size_t width{m_segments.size() * 3};
+    std::vector<size_t> keys(m_out_nodes.size() * width);
+    for (size_t i = 0; i < m_out_nodes.size(); i++) {
+      size_t step{m_out_steps[i]};
+      for (size_t j = m_segments.size(); j-- > 0;) {
+        const auto& step_{m_steps[step]};
+        keys[i * width + j * 3] = step_.node;
+        keys[i * width + j * 3 + 1] = step_.selector;
+        keys[i * width + j * 3 + 2] = step_.position;
+        step = step_.parent;
+      }
     }
 
-    // Handle negative start values.
-    if (!selector.start) {
-      start = step < 0 ? length - 1 : 0UL;
-    } else if (selector.start.value() < 0) {
-      start = std::max(length + selector.start.value(), std::int64_t{0});
-    } else {
-      start = std::min(selector.start.value(), length - 1);
+    auto less = [&keys, width](size_t a, size_t b) {
+      return std::lexicographical_compare(
+          keys.begin() + a * width, keys.begin() + (a + 1) * width,
+          keys.begin() + b * width, keys.begin() + (b + 1) * width);
+    };
+
+    std::vector<size_t> order(m_out_nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(order.begin(), order.end(), less)) {
+      std::sort(order.begin(), order.end(), less);
     }
 
-    // Handle negative stop values
-    if (!selector.stop) {
-      stop = step < 0 ? -1 : size;
-    } else if (selector.stop.value() < 0) {
-      stop = std::max(length + selector.stop.value(), std::int64_t{-1});
-    } else {
-      stop = std::min(selector.stop.value(), length);
+    std::vector<node_t> rv{};
+    rv.reserve(order.size());
+    for (auto i : order) {
+      rv.push_back(std::move(m_out_nodes[i]));
     }
+    return rv;
+  }
+};
+
+// Apply _segments_ to _start_, which is the root object in _q_ctx_ unless
+// we're evaluating a relative query in a filter.
+template <typename Nodes>
+std::vector<typename Nodes::node_t> resolve(const QueryContext& q_ctx,
+                                            const segments_t& segments,
+                                            nb::object start) {
+  if (SegmentAutomaton<Nodes>::supports(segments)) {
+    return SegmentAutomaton<Nodes>{segments, q_ctx.names}.run(
+        Nodes::root(start));
+  }
+
+  // Bootstrap the node list with the start object and an empty location.
+  // Each segment reads from one buffer and writes to the other.
+  using node_t = typename Nodes::node_t;
+  std::vector<node_t> nodes{PooledVector<node_t>::acquire()};
+  nodes.push_back(Nodes::root(start));
+  PooledVector<node_t> out_nodes{};
+
+  for (const auto& segment : segments) {
+    out_nodes->clear();
+    std::visit(SegmentVisitor<Nodes>{q_ctx, nodes, &*out_nodes}, segment);
+    nodes.swap(*out_nodes);
+  }
+  return nodes;
+}
 
-    // TODO: return start, stop and step
-    // TODO: then loop in the caller
-    std::vector<std::int64_t> indicies{};
-    if (step > 0) {
-      for (int64_t i = start; i < stop; i += step) {
-        indicies.push_back(i);
+// Apply singular query _segments_ to _start_, following each name or index
+// selector directly instead of building a node list for every segment.
+// Return the selected node, or nothing if any step is missing.
+template <typename Nodes>
+std::optional<typename Nodes::node_t> resolve_singular(
+    const QueryContext& q_ctx, const segments_t& segments, nb::object start) {
+  auto node{Nodes::root(start)};
+  for (const auto& segment : segments) {
+    const auto& selector{segment_selectors(segment)[0]};
+    if (auto name_ = std::get_if<NameSelector>(&selector)) {
+      const nb::str& name{q_ctx.names.get(*name_)};
+      nb::object val{name_value(Nodes::value(node), name)};
+      if (!val.is_valid()) {
+        return std::nullopt;
       }
+      node = Nodes::child(node, val, name);
     } else {
-      for (int64_t i = start; i > stop; i += step) {
-        indicies.push_back(i);
+      size_t index{0};
+      nb::object val{index_value(Nodes::value(node),
+                                 std::get<IndexSelector>(selector), index)};
+      if (!val.is_valid()) {
+        return std::nullopt;
       }
+      node = Nodes::child(node, val, index);
     }
-    return indicies;
   }
-};
+  return node;
+}
 
-class SegmentVisitor {
+// Move values into a new Python list.
+nb::list to_list(std::vector<nb::object>& values) {
+  auto rv{nb::steal<nb::list>(PyList_New(values.size()))};
+  for (size_t i = 0; i < values.size(); i++) {
+    // PyList_SetItem steals a reference.
+    PyList_SetItem(rv.ptr(), i, values[i].release().ptr());
+  }
+  return rv;
+}
+
+// Lazily apply one segment to one node, producing matching nodes one at a
+// time. Position within the current selector is kept between calls to
+// `next`, so we never hold more than one of the node's children.
+class SegmentCursor {
 private:
-  const QueryContext& m_context;
-  const std::vector<JSONPathNode>& m_nodes;
-  std::vector<JSONPathNode>* m_out_nodes;
+  const QueryContext* m_context;
+  const selector_list_t* m_selectors;
+  JSONPathNode m_node;
+  bool m_recursive;
+
+  // Descendants of the input node, when applying a recursive segment.
+  std::optional<Descendants<LocatedNodes>> m_descendants{};
+
+  // Selector and position within that selector's candidate children.
+  size_t m_selector{0};
+  Py_ssize_t m_position{0};
+  std::optional<SliceBounds> m_slice{};
+  std::optional<FilterMachine> m_filter{};
 
 public:
-  SegmentVisitor(const QueryContext& q_ctx,
-                 const std::vector<JSONPathNode>& nodes,
-                 std::vector<JSONPathNode>* out_nodes)
-      : m_context{q_ctx}, m_nodes{nodes}, m_out_nodes{out_nodes} {}
+  SegmentCursor(const QueryContext& q_ctx,
+                const std::variant<Segment, RecursiveSegment>& segment,
+                JSONPathNode node)
+      : m_context{&q_ctx},
+        m_selectors{std::holds_alternative<Segment>(segment)
+                        ? &std::get<Segment>(segment).selectors
+                        : &std::get<RecursiveSegment>(segment).selectors},
+        m_node{std::move(node)},
+        m_recursive{std::holds_alternative<RecursiveSegment>(segment)} {
+    if (m_recursive) {
+      m_descendants.emplace(m_node);
+      m_node = *m_descendants->next();
+    }
+  }
 
-  ~SegmentVisitor() = default;
+  // Return the next node selected by this segment, or nothing if there are
+  // no more matches.
+  std::optional<JSONPathNode> next() {
+    while (true) {
+      if (m_selector < m_selectors->size()) {
+        auto node{std::visit(*this, (*m_selectors)[m_selector])};
+        if (node) {
+          return node;
+        }
 
-  void operator()(const Segment& segment) {
-    for (auto node : m_nodes) {
-      SelectorVisitor visitor{m_context, node, m_out_nodes};
-      for (auto selector : segment.selectors) {
-        std::visit(visitor, selector);
+        m_selector++;
+        m_position = 0;
+        m_slice.reset();
+        m_filter.reset();
+        continue;
+      }
+
+      if (!m_recursive) {
+        return std::nullopt;
+      }
+
+      auto descendant{m_descendants->next()};
+      if (!descendant) {
+        return std::nullopt;
       }
+
+      m_node = std::move(*descendant);
+      m_selector = 0;
     }
   }
 
-  void operator()(const RecursiveSegment& segment) {
-    for (auto node : m_nodes) {
-      std::vector<JSONPathNode> descendants{};
-      descend(node, descendants);
-      for (auto descendant : descendants) {
-        SelectorVisitor visitor{m_context, descendant, m_out_nodes};
-        for (auto selector : segment.selectors) {
-          std::visit(visitor, selector);
+  std::optional<JSONPathNode> operator()(const NameSelector& selector) {
+    if (m_position++ != 0) {
+      return std::nullopt;
+    }
+
+    const nb::str& name{m_context->names.get(selector)};
+    if (nb::object val{name_value(m_node.value, name)}; val.is_valid()) {
+      return child(val, name);
+    }
+    return std::nullopt;
+  }
+
+  std::optional<JSONPathNode> operator()(const IndexSelector& selector) {
+    if (m_position++ != 0) {
+      return std::nullopt;
+    }
+
+    size_t index{0};
+    if (nb::object val{index_value(m_node.value, selector, index)};
+        val.is_valid()) {
+      return child(val, index);
+    }
+    return std::nullopt;
+  }
+
+  std::optional<JSONPathNode> operator()(const WildSelector&) {
+    if (nb::isinstance<nb::dict>(m_node.value)) {
+      nb::ft_object_guard guard{m_node.value};
+      PyObject* key{nullptr};
+      PyObject* val{nullptr};
+      if (PyDict_Next(m_node.value.ptr(), &m_position, &key, &val)) {
+        nb::object val_{nb::borrow(val)};
+        return child(val_, nb::handle{key});
+      }
+    } else if (nb::isinstance<nb::list>(m_node.value)) {
+      auto obj{nb::cast<nb::list>(m_node.value)};
+      if (static_cast<size_t>(m_position) < nb::len(obj)) {
+        size_t index{static_cast<size_t>(m_position++)};
+        nb::object val{obj[index]};
+        return child(val, index);
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<JSONPathNode> operator()(const SliceSelector& selector) {
+    if (nb::isinstance<nb::list>(m_node.value)) {
+      auto obj{nb::cast<nb::list>(m_node.value)};
+      if (!m_slice) {
+        m_slice = slice_bounds(selector, obj.size());
+        m_position = m_slice->start;
+      }
+
+      if (m_slice->in_range(m_position)) {
+        size_t index{static_cast<size_t>(m_position)};
+        m_position += m_slice->step;
+        nb::object val{obj[index]};
+        return child(val, index);
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<JSONPathNode> operator()(
+      const Box<FilterSelector>& selector) {
+    if (nb::isinstance<nb::dict>(m_node.value)) {
+      nb::ft_object_guard guard{m_node.value};
+      PyObject* key{nullptr};
+      PyObject* val{nullptr};
+      while (PyDict_Next(m_node.value.ptr(), &m_position, &key, &val)) {
+        nb::object key_{nb::borrow(key)};
+        nb::object val_{nb::borrow(val)};
+        if (test(selector, val_)) {
+          return child(val_, key_);
+        }
+      }
+    } else if (nb::isinstance<nb::list>(m_node.value)) {
+      auto obj{nb::cast<nb::list>(m_node.value)};
+      while (static_cast<size_t>(m_position) < nb::len(obj)) {
+        size_t index{static_cast<size_t>(m_position++)};
+        nb::object val{obj[index]};
+        if (test(selector, val)) {
+          return child(val, index);
         }
       }
     }
+    return std::nullopt;
+  }
+
+private:
+  template <typename Key>
+  JSONPathNode child(nb::object& val, const Key& key) const {
+    return LocatedNodes::child(m_node, val, key);
+  }
+
+  bool test(const Box<FilterSelector>& selector, const nb::object& val) {
+    if (!m_filter) {
+      m_filter.emplace(*m_context, *selector);
+    }
+    return m_filter->test(val);
   }
 };
 
-JSONPathNodeList resolve_segment(
-    const QueryContext& q_ctx, const JSONPathNodeList& nodes,
-    const std::variant<libjsonpath::Segment, libjsonpath::RecursiveSegment>&
-        segment) {
-  JSONPathNodeList out_nodes{};
-  SegmentVisitor visitor{q_ctx, nodes, &out_nodes};
-  std::visit(visitor, segment);
-  return out_nodes;
+// Pull-based, depth-first evaluation of _segments_. The stack holds at most
+// one cursor per segment.
+class DepthFirstQuery {
+private:
+  const QueryContext& m_context;
+  const segments_t& m_segments;
+  nb::object m_start;
+  std::vector<SegmentCursor> m_stack{};
+  bool m_started{false};
+
+public:
+  DepthFirstQuery(const QueryContext& q_ctx, const segments_t& segments,
+                  nb::object start)
+      : m_context{q_ctx}, m_segments{segments}, m_start{std::move(start)} {}
+
+  // Return the next node, or nothing if the query is exhausted.
+  std::optional<JSONPathNode> next() {
+    nb::object root{m_start};
+
+    if (!m_started) {
+      m_started = true;
+      if (m_segments.empty()) {
+        return JSONPathNode{root, {}};
+      }
+      m_stack.emplace_back(m_context, m_segments[0], JSONPathNode{root, {}});
+    }
+
+    while (!m_stack.empty()) {
+      auto node{m_stack.back().next()};
+      if (!node) {
+        m_stack.pop_back();
+      } else if (m_stack.size() == m_segments.size()) {
+        return node;
+      } else {
+        m_stack.emplace_back(m_context, m_segments[m_stack.size()],
+                             std::move(*node));
+      }
+    }
+
+    return std::nullopt;
+  }
+};
+
+// Return at most the first _limit_ nodes matching _segments_, without
+// evaluating the rest of the query.
+JSONPathNodeList resolve_first(const QueryContext& q_ctx,
+                               const segments_t& segments, nb::object start,
+                               size_t limit) {
+  JSONPathNodeList nodes{};
+  DepthFirstQuery query{q_ctx, segments, std::move(start)};
+  while (nodes.size() < limit) {
+    auto node{query.next()};
+    if (!node) {
+      break;
+    }
+    nodes.push_back(std::move(*node));
+  }
+  return nodes;
+}
+
+struct NodeIterator::State {
+  State(std::shared_ptr<const QueryPlan> plan_, QueryContext context_)
+      : plan{std::move(plan_)},
+        context{std::move(context_)},
+        query{context, plan->segments, context.root} {}
+
+  std::shared_ptr<const QueryPlan> plan;
+  QueryContext context;
+  DepthFirstQuery query;
+  std::atomic<bool> running{false};
+};
+
+NodeIterator::NodeIterator(std::unique_ptr<State> state)
+    : m_state{std::move(state)} {}
+
+NodeIterator::NodeIterator(NodeIterator&&) noexcept = default;
+
+NodeIterator::~NodeIterator() = default;
+
+std::optional<JSONPathNode> NodeIterator::next() {
+  Running running{m_state->running};
+  return m_state->query.next();
 }
 
 // TODO: Don't pass context around, make all these functions methods of a
 // class.
 
 JSONPathNodeList query_(const segments_t& segments, nb::object obj,
-                        function_extension_map functions,
-                        function_signature_map signatures, nb::object nothing) {
-  QueryContext q_ctx{obj, functions, signatures, nothing};
-  // Bootstrap the node list with root object and an empty location.
-  JSONPathNodeList nodes{{obj, {}}};
-  for (auto segment : segments) {
-    nodes = resolve_segment(q_ctx, nodes, segment);
-  }
-  return nodes;
+                        const function_extension_map& functions,
+                        const function_signature_map& signatures,
+                        nb::object nothing) {
+  FilterPrograms filters{segments, functions, signatures};
+  SelectorNames names{segments};
+  QueryContext q_ctx{obj, nothing, filters, names};
+  return resolve<LocatedNodes>(q_ctx, segments, obj);
 }
 
 JSONPathNodeList query_(std::string_view path, nb::object obj,
-                        function_extension_map functions,
-                        function_signature_map signatures, nb::object nothing) {
+                        const function_extension_map& functions,
+                        const function_signature_map& signatures,
+                        nb::object nothing) {
   segments_t segments{parse(path, signatures)};
-  QueryContext q_ctx{obj, functions, signatures, nothing};
-  // Bootstrap the node list with root object and an empty location.
-  JSONPathNodeList nodes{{obj, {}}};
-  for (auto segment : segments) {
-    nodes = resolve_segment(q_ctx, nodes, segment);
-  }
-  return nodes;
+  FilterPrograms filters{segments, functions, signatures};
+  SelectorNames names{segments};
+  QueryContext q_ctx{obj, nothing, filters, names};
+  return resolve<LocatedNodes>(q_ctx, segments, obj);
 }
 
+QueryPlan::QueryPlan(std::string_view path_, const Parser& parser,
+                     const function_extension_map& functions,
+                     const function_signature_map& signatures,
+                     nb::handle nothing)
+    : path{path_},
+      segments{parser.parse(path)},
+      filters{segments, functions, signatures},
+      names{segments},
+      document_filters{segments, filters, nothing},
+      singular{singular_query(segments)} {}
+
+QueryPlan::QueryPlan(segments_t segments_,
+                     const function_extension_map& functions,
+                     const function_signature_map& signatures,
+                     nb::handle nothing)
+    : path{to_string(segments_)},
+      segments{std::move(segments_)},
+      filters{segments, functions, signatures},
+      names{segments},
+      document_filters{segments, filters, nothing},
+      singular{singular_query(segments)} {}
+
 JSONPathNodeList Env_::query(std::string_view path, nb::object obj) {
-  segments_t segments{m_parser.parse(path)};
-  QueryContext q_ctx{obj, m_functions, m_signatures, m_nothing};
-  // Bootstrap the node list with root object and an empty location.
-  JSONPathNodeList nodes{{obj, {}}};
-  for (auto segment : segments) {
-    nodes = resolve_segment(q_ctx, nodes, segment);
-  }
-  return nodes;
+  return query(*plan(path), obj);
+}
+
+JSONPathNodeList Env_::query(const QueryPlan& plan, nb::object obj) {
+  QueryContext q_ctx{obj, m_nothing, plan.filters, plan.names};
+  return resolve<LocatedNodes>(q_ctx, plan.segments, obj);
 }
 
 JSONPathNodeList Env_::from_segments(const segments_t& segments,
                                      nb::object obj) {
-  QueryContext q_ctx{obj, m_functions, m_signatures, m_nothing};
-  // Bootstrap the node list with root object and an empty location.
-  JSONPathNodeList nodes{{obj, {}}};
-  for (auto segment : segments) {
-    nodes = resolve_segment(q_ctx, nodes, segment);
+  auto snapshot_{snapshot()};
+  FilterPrograms filters{segments, snapshot_->functions, snapshot_->signatures};
+  SelectorNames names{segments};
+  QueryContext q_ctx{obj, m_nothing, filters, names};
+  return resolve<LocatedNodes>(q_ctx, segments, obj);
+}
+
+nb::list Env_::findall(std::string_view path, nb::object obj) {
+  return findall(*plan(path), obj);
+}
+
+nb::list Env_::findall(const QueryPlan& plan, nb::object obj) {
+  QueryContext q_ctx{obj, m_nothing, plan.filters, plan.names};
+  auto values{resolve<ValueNodes>(q_ctx, plan.segments, obj)};
+  auto rv{to_list(values)};
+  PooledVector<nb::object>::release(std::move(values));
+  return rv;
+}
+
+nb::object Env_::get(std::string_view path, nb::object obj) {
+  return get(*plan(path), obj);
+}
+
+nb::object Env_::get(const QueryPlan& plan, nb::object obj) {
+  QueryContext q_ctx{obj, m_nothing, plan.filters, plan.names};
+  if (plan.singular) {
+    auto value{resolve_singular<ValueNodes>(q_ctx, plan.segments, obj)};
+    return value ? *value : m_nothing;
   }
-  return nodes;
+  auto node{DepthFirstQuery{q_ctx, plan.segments, obj}.next()};
+  return node ? node->value : m_nothing;
+}
+
+std::optional<JSONPathNode> Env_::query_one(std::string_view path,
+                                            nb::object obj) {
+  return query_one(*plan(path), obj);
+}
+
+std::optional<JSONPathNode> Env_::query_one(const QueryPlan& plan,
+                                            nb::object obj) {
+  QueryContext q_ctx{obj, m_nothing, plan.filters, plan.names};
+  if (plan.singular) {
+    return resolve_singular<LocatedNodes>(q_ctx, plan.segments, obj);
+  }
+  return DepthFirstQuery{q_ctx, plan.segments, obj}.next();
+}
+
+JSONPathNodeList Env_::query(std::string_view path, const JSONDocument& doc) {
+  return query(*plan(path), doc);
+}
+
+JSONPathNodeList Env_::query(const QueryPlan& plan, const JSONDocument& doc) {
+  return query_document(doc, plan, m_nothing,
+                        {m_parallel_threshold, &m_pool});
+}
+
+nb::list Env_::findall(std::string_view path, const JSONDocument& doc) {
+  return findall(*plan(path), doc);
+}
+
+nb::list Env_::findall(const QueryPlan& plan, const JSONDocument& doc) {
+  return findall_document(doc, plan, m_nothing,
+                          {m_parallel_threshold, &m_pool});
 }
 
-segments_t Env_::parse(std::string_view path) { return m_parser.parse(path); }
+nb::object Env_::findall_array(std::string_view path, nb::object obj,
+                               std::string_view dtype, bool masked) {
+  return findall_array(*plan(path), obj, dtype, masked);
+}
+
+nb::object Env_::findall_array(const QueryPlan& plan, nb::object obj,
+                               std::string_view dtype, bool masked) {
+  TypedArray rv{dtype, masked};
+  QueryContext q_ctx{obj, m_nothing, plan.filters, plan.names};
+  auto values{resolve<ValueNodes>(q_ctx, plan.segments, obj)};
+  rv.reserve(values.size());
+  for (const auto& value : values) {
+    rv.push(value);
+  }
+  PooledVector<nb::object>::release(std::move(values));
+  return rv.to_python();
+}
+
+nb::object Env_::findall_array(std::string_view path, const JSONDocument& doc,
+                               std::string_view dtype, bool masked) {
+  return findall_array(*plan(path), doc, dtype, masked);
+}
+
+nb::object Env_::findall_array(const QueryPlan& plan, const JSONDocument& doc,
+                               std::string_view dtype, bool masked) {
+  return findall_array_document(doc, plan, m_nothing,
+                                {m_parallel_threshold, &m_pool}, dtype, masked);
+}
+
+nb::bytes Env_::findall_json(std::string_view path, nb::object obj) {
+  return findall_json(*plan(path), obj);
+}
+
+nb::bytes Env_::findall_json(const QueryPlan& plan, nb::object obj) {
+  QueryContext q_ctx{obj, m_nothing, plan.filters, plan.names};
+  auto values{resolve<ValueNodes>(q_ctx, plan.segments, obj)};
+  JSONWriter writer{};
+  writer.write_raw("[");
+  for (size_t i = 0; i < values.size(); i++) {
+    if (i) {
+      writer.write_raw(",");
+    }
+    writer.write(values[i]);
+  }
+  writer.write_raw("]");
+  PooledVector<nb::object>::release(std::move(values));
+  return writer.to_bytes();
+}
+
+nb::bytes Env_::findall_json(std::string_view path, const JSONDocument& doc) {
+  return findall_json(*plan(path), doc);
+}
+
+nb::bytes Env_::findall_json(const QueryPlan& plan, const JSONDocument& doc) {
+  return findall_json_document(doc, plan, m_nothing,
+                               {m_parallel_threshold, &m_pool});
+}
+
+nb::bytes Env_::query_json(std::string_view path, nb::object obj) {
+  return query_json(*plan(path), obj);
+}
+
+nb::bytes Env_::query_json(const QueryPlan& plan, nb::object obj) {
+  auto nodes{query(plan, obj)};
+  JSONWriter writer{};
+  writer.write_raw("[");
+  for (size_t i = 0; i < nodes.size(); i++) {
+    writer.write_raw(i ? ",{\"path\":" : "{\"path\":");
+    writer.write_string(nodes[i].path());
+    writer.write_raw(",\"value\":");
+    writer.write(nodes[i].value);
+    writer.write_raw("}");
+  }
+  writer.write_raw("]");
+  return writer.to_bytes();
+}
+
+nb::bytes Env_::query_json(std::string_view path, const JSONDocument& doc) {
+  return query_json(*plan(path), doc);
+}
+
+nb::bytes Env_::query_json(const QueryPlan& plan, const JSONDocument& doc) {
+  return query_json_document(doc, plan, m_nothing,
+                             {m_parallel_threshold, &m_pool});
+}
+
+void Env_::register_function(const std::string& name, nb::callable func,
+                             const FunctionExtensionTypes& signature) {
+  std::lock_guard<std::mutex> lock{m_register_mutex};
+  auto current{snapshot()};
+  auto functions{current->functions};
+  auto signatures{current->signatures};
+  functions.insert_or_assign(name, std::move(func));
+  signatures.insert_or_assign(name, signature);
+  std::atomic_store(&m_snapshot,
+                    std::make_shared<const Snapshot>(std::move(functions),
+                                                     std::move(signatures),
+                                                     m_cache_size));
+}
+
+segments_t Env_::parse(std::string_view path) {
+  return snapshot()->parser.parse(path);
+}
+
+std::shared_ptr<const QueryPlan> Env_::plan(std::string_view path) {
+  auto snapshot_{snapshot()};
+  return snapshot_->cache.get_or_insert(path, [&]() {
+    return std::make_shared<const QueryPlan>(path, snapshot_->parser,
+                                             snapshot_->functions,
+                                             snapshot_->signatures, m_nothing);
+  });
+}
+
+CompiledQuery Env_::compile(std::string_view path) {
+  return CompiledQuery{this, plan(path)};
+}
+
+CompiledQuery Env_::compile(const segments_t& segments) {
+  auto snapshot_{snapshot()};
+  auto plan_{std::make_shared<const QueryPlan>(
+      segments, snapshot_->functions, snapshot_->signatures, m_nothing)};
+  return CompiledQuery{this, std::move(plan_)};
+}
+
+CompiledQuerySet Env_::query_set(const std::vector<std::string>& paths) {
+  std::vector<std::shared_ptr<const QueryPlan>> plans{};
+  plans.reserve(paths.size());
+  for (const auto& path : paths) {
+    plans.push_back(plan(path));
+  }
+  return CompiledQuerySet{std::move(plans), m_nothing};
+}
+
+NodeIterator Env_::finditer(std::string_view path, nb::object obj) {
+  return finditer(plan(path), obj);
+}
+
+NodeIterator Env_::finditer(std::shared_ptr<const QueryPlan> plan,
+                            nb::object obj) {
+  QueryContext q_ctx{obj, m_nothing, plan->filters, plan->names};
+  return NodeIterator{
+      std::make_unique<NodeIterator::State>(std::move(plan), q_ctx)};
+}
+
+NDJSONIterator Env_::query_ndjson(std::string_view query,
+                                  const std::string& path, size_t threads,
+                                  bool ordered) {
+  return ndjson(plan(query), path, threads, ordered, false);
+}
+
+NDJSONIterator Env_::findall_ndjson(std::string_view query,
+                                    const std::string& path, size_t threads,
+                                    bool ordered) {
+  return ndjson(plan(query), path, threads, ordered, true);
+}
+
+NDJSONIterator Env_::ndjson(std::shared_ptr<const QueryPlan> plan,
+                            const std::string& path, size_t threads,
+                            bool ordered, bool values) {
+  return ndjson_iterator(path, std::move(plan), m_nothing, threads, ordered,
+                         values);
+}
+
+CacheInfo Env_::cache_info() const { return snapshot()->cache.info(); }
+
+void Env_::cache_clear() { snapshot()->cache.clear(); }
+
+JSONPathNodeList CompiledQuery::query(nb::object obj) const {
+  return m_env->query(*m_plan, obj);
+}
+
+NodeIterator CompiledQuery::finditer(nb::object obj) const {
+  return m_env->finditer(m_plan, obj);
+}
+
+nb::list CompiledQuery::findall(nb::object obj) const {
+  return m_env->findall(*m_plan, obj);
+}
+
+nb::object CompiledQuery::findall_array(nb::object obj, std::string_view dtype,
+                                       bool masked) const {
+  return m_env->findall_array(*m_plan, obj, dtype, masked);
+}
+
+nb::object CompiledQuery::findall_array(const JSONDocument& doc,
+                                       std::string_view dtype,
+                                       bool masked) const {
+  return m_env->findall_array(*m_plan, doc, dtype, masked);
+}
+
+nb::bytes CompiledQuery::findall_json(nb::object obj) const {
+  return m_env->findall_json(*m_plan, obj);
+}
+
+nb::bytes CompiledQuery::findall_json(const JSONDocument& doc) const {
+  return m_env->findall_json(*m_plan, doc);
+}
+
+nb::bytes CompiledQuery::query_json(nb::object obj) const {
+  return m_env->query_json(*m_plan, obj);
+}
+
+nb::bytes CompiledQuery::query_json(const JSONDocument& doc) const {
+  return m_env->query_json(*m_plan, doc);
+}
+
+JSONPathNodeList CompiledQuery::query(const JSONDocument& doc) const {
+  return m_env->query(*m_plan, doc);
+}
+
+nb::list CompiledQuery::findall(const JSONDocument& doc) const {
+  return m_env->findall(*m_plan, doc);
+}
+
+nb::object CompiledQuery::get(nb::object obj) const {
+  return m_env->get(*m_plan, obj);
+}
+
+std::optional<JSONPathNode> CompiledQuery::query_one(nb::object obj) const {
+  return m_env->query_one(*m_plan, obj);
+}
+
+NDJSONIterator CompiledQuery::query_ndjson(const std::string& path,
+                                           size_t threads, bool ordered) const {
+  return m_env->ndjson(m_plan, path, threads, ordered, false);
+}
+
+NDJSONIterator CompiledQuery::findall_ndjson(const std::string& path,
+                                             size_t threads,
+                                             bool ordered) const {
+  return m_env->ndjson(m_plan, path, threads, ordered, true);
+}
+
+// Return true if selectors _a_ and _b_ always select the same nodes. We don't
+// compare filter selectors, so they are never the same.
+bool same_selector(const selector_list_t::value_type& a,
+                   const selector_list_t::value_type& b) {
+  if (a.index() != b.index()) {
+    return false;
+  }
+  if (auto name = std::get_if<NameSelector>(&a)) {
+    return name->name == std::get<NameSelector>(b).name;
+  }
+  if (auto index = std::get_if<IndexSelector>(&a)) {
+    return index->index == std::get<IndexSelector>(b).index;
+  }
+  if (auto slice = std::get_if<SliceSelector>(&a)) {
+    const auto& other{std::get<SliceSelector>(b)};
+    return slice->start == other.start && slice->stop == other.stop &&
+           slice->step == other.step;
+  }
+  return std::holds_alternative<WildSelector>(a);
+}
+
+bool same_segment(const segments_t::value_type& a,
+                  const segments_t::value_type& b) {
+  if (a.index() != b.index()) {
+    return false;
+  }
+  const auto& selectors{segment_selectors(a)};
+  const auto& other{segment_selectors(b)};
+  if (selectors.size() != other.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < selectors.size(); i++) {
+    if (!same_selector(selectors[i], other[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CompiledQuerySet::CompiledQuerySet(
+    std::vector<std::shared_ptr<const QueryPlan>> plans, nb::object nothing)
+    : m_plans{std::move(plans)}, m_nothing{nothing}, m_branches{{}} {
+  for (size_t i = 0; i < m_plans.size(); i++) {
+    size_t branch{0};
+    for (const auto& segment : m_plans[i]->segments) {
+      std::optional<size_t> next{};
+      for (auto child : m_branches[branch].children) {
+        if (same_segment(*m_branches[child].segment, segment)) {
+          next = child;
+          break;
+        }
+      }
+      if (!next) {
+        next = m_branches.size();
+        m_branches[branch].children.push_back(*next);
+        m_branches.push_back({&segment, i, {}, {}});
+      }
+      branch = *next;
+    }
+    m_branches[branch].queries.push_back(i);
+  }
+}
+
+template <typename Nodes>
+std::vector<std::vector<typename Nodes::node_t>> CompiledQuerySet::run(
+    nb::object obj) const {
+  using node_t = typename Nodes::node_t;
+  std::vector<std::vector<node_t>> results(m_plans.size());
+
+  // Filters and names are compiled per plan, so each plan gets its own
+  // context.
+  std::vector<QueryContext> contexts{};
+  contexts.reserve(m_plans.size());
+  for (const auto& plan : m_plans) {
+    contexts.emplace_back(obj, m_nothing, plan->filters, plan->names);
+  }
+
+  std::vector<node_t> root{Nodes::root(obj)};
+  visit<Nodes>(contexts, 0, root, results);
+  return results;
+}
+
+// Evaluate the trie depth first. Each branch's segment is applied to the
+// nodes selected by its parent, and queries ending at a branch get a copy of
+// its nodes.
+template <typename Nodes>
+void CompiledQuerySet::visit(
+    const std::vector<QueryContext>& contexts, size_t index,
+    const std::vector<typename Nodes::node_t>& nodes,
+    std::vector<std::vector<typename Nodes::node_t>>& results) const {
+  const Branch& branch{m_branches[index]};
+  for (auto query : branch.queries) {
+    results[query] = nodes;
+  }
+
+  if (nodes.empty()) {
+    return;
+  }
+
+  for (auto child : branch.children) {
+    const Branch& child_{m_branches[child]};
+    PooledVector<typename Nodes::node_t> out_nodes{};
+    std::visit(
+        SegmentVisitor<Nodes>{contexts[child_.plan], nodes, &*out_nodes},
+        *child_.segment);
+    visit<Nodes>(contexts, child, *out_nodes, results);
+  }
+}
+
+std::vector<JSONPathNodeList> CompiledQuerySet::query(nb::object obj) const {
+  return run<LocatedNodes>(obj);
+}
+
+nb::list CompiledQuerySet::findall(nb::object obj) const {
+  nb::list rv{};
+  for (auto& values : run<ValueNodes>(obj)) {
+    rv.append(to_list(values));
+  }
+  return rv;
+}
+
+std::vector<std::string> CompiledQuerySet::paths() const {
+  std::vector<std::string> rv{};
+  rv.reserve(m_plans.size());
+  for (const auto& plan : m_plans) {
+    rv.push_back(plan->path);
+  }
+  return rv;
+}
 
-}  // namespace libjsonpath
\ No newline at end of file
+}  // namespace libjsonpath
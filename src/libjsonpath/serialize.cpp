@@ -0,0 +1,271 @@
+#include "libjsonpath/serialize.hpp"
+
+#include <charconv>  // std::to_chars
+#include <cmath>     // std::isnan std::isinf
+#include <string>    // std::string
+
+#include "libjsonpath/containers.hpp"
+
+namespace libjsonpath {
+
+namespace {
+
+constexpr char hex_digits[] = "0123456789abcdef";
+
+void append_escape(std::string& out, unsigned int code) {
+  out.append("\\u");
+  out.push_back(hex_digits[(code >> 12) & 0xF]);
+  out.push_back(hex_digits[(code >> 8) & 0xF]);
+  out.push_back(hex_digits[(code >> 4) & 0xF]);
+  out.push_back(hex_digits[code & 0xF]);
+}
+
+// Append UTF-8 encoded _text_ to _out_, replacing surrogates with \u
+// escapes. If _string_ is true, _text_ is the contents of a string, and
+// quotes, backslashes and control characters are escaped too.
+void append_text(std::string& out, std::string_view text, bool string) {
+  size_t start{0};
+  for (size_t i = 0; i < text.size(); i++) {
+    auto c{static_cast<unsigned char>(text[i])};
+    if (c == 0xED && i + 2 < text.size() &&
+        static_cast<unsigned char>(text[i + 1]) >= 0xA0) {
+      // U+D800 to U+DFFF.
+      out.append(text.substr(start, i - start));
+      append_escape(out, 0xD000 |
+                             ((static_cast<unsigned char>(text[i + 1]) & 0x3F)
+                              << 6) |
+                             (static_cast<unsigned char>(text[i + 2]) & 0x3F));
+      i += 2;
+      start = i + 1;
+      continue;
+    }
+
+    if (!string || (c >= 0x20 && c != '"' && c != '\\')) {
+      continue;
+    }
+
+    out.append(text.substr(start, i - start));
+    start = i + 1;
+    switch (c) {
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      case '\r':
+        out.append("\\r");
+        break;
+      case '\t':
+        out.append("\\t");
+        break;
+      case '\b':
+        out.append("\\b");
+        break;
+      case '\f':
+        out.append("\\f");
+        break;
+      default:
+        append_escape(out, c);
+    }
+  }
+  out.append(text.substr(start));
+}
+
+// Return the UTF-8 encoding of the str _value_, using _bytes_ to hold it if
+// _value_ has lone surrogates.
+std::string_view utf8(PyObject* value, nb::object& bytes) {
+  Py_ssize_t size{0};
+  const char* data{PyUnicode_AsUTF8AndSize(value, &size)};
+  if (data) {
+    return {data, static_cast<size_t>(size)};
+  }
+
+  PyErr_Clear();
+  bytes =
+      nb::steal(PyUnicode_AsEncodedString(value, "utf-8", "surrogatepass"));
+  if (!bytes.is_valid()) {
+    throw nb::python_error();
+  }
+  char* encoded{nullptr};
+  if (PyBytes_AsStringAndSize(bytes.ptr(), &encoded, &size) == -1) {
+    throw nb::python_error();
+  }
+  return {encoded, static_cast<size_t>(size)};
+}
+
+}  // namespace
+
+void JSONWriter::write(nb::handle value) {
+  PyObject* obj{value.ptr()};
+  if (obj == Py_None) {
+    m_out.append("null");
+  } else if (obj == Py_True) {
+    m_out.append("true");
+  } else if (obj == Py_False) {
+    m_out.append("false");
+  } else if (PyUnicode_CheckExact(obj)) {
+    write_str(obj);
+  } else if (PyLong_CheckExact(obj)) {
+    int overflow{0};
+    long long integer{PyLong_AsLongLongAndOverflow(obj, &overflow)};
+    if (overflow) {
+      auto text{nb::steal(PyObject_Str(obj))};
+      if (!text.is_valid()) {
+        throw nb::python_error();
+      }
+      nb::object bytes{};
+      m_out.append(utf8(text.ptr(), bytes));
+    } else if (integer == -1 && PyErr_Occurred()) {
+      throw nb::python_error();
+    } else {
+      write_integer(integer);
+    }
+  } else if (PyFloat_CheckExact(obj)) {
+    write_real(PyFloat_AsDouble(obj));
+  } else if (PyDict_CheckExact(obj)) {
+    write_dict(obj);
+  } else if (PyList_CheckExact(obj)) {
+    write_list(obj);
+  } else {
+    write_other(value);
+  }
+}
+
+void JSONWriter::write_string(std::string_view value) {
+  m_out.push_back('"');
+  append_text(m_out, value, true);
+  m_out.push_back('"');
+}
+
+void JSONWriter::write_integer(std::int64_t value) {
+  char buf[24];
+  auto result{std::to_chars(buf, buf + sizeof(buf), value)};
+  m_out.append(buf, result.ptr);
+}
+
+// Like float.__repr__, which is what json.dumps uses too.
+void JSONWriter::write_real(double value) {
+  if (std::isnan(value)) {
+    m_out.append("NaN");
+    return;
+  }
+  if (std::isinf(value)) {
+    m_out.append(value < 0 ? "-Infinity" : "Infinity");
+    return;
+  }
+
+  char* text{PyOS_double_to_string(value, 'r', 0, Py_DTSF_ADD_DOT_0, nullptr)};
+  if (!text) {
+    throw nb::python_error();
+  }
+  m_out.append(text);
+  PyMem_Free(text);
+}
+
+nb::bytes JSONWriter::to_bytes() const {
+  return nb::bytes(m_out.data(), m_out.size());
+}
+
+JSONWriter::Marker::Marker(JSONWriter& writer, PyObject* value)
+    : m_writer{writer}, m_value{value} {
+  if (!m_writer.m_markers.insert(m_value).second) {
+    throw nb::value_error("Circular reference detected");
+  }
+}
+
+JSONWriter::Marker::~Marker() { m_writer.m_markers.erase(m_value); }
+
+void JSONWriter::write_str(PyObject* value) {
+  nb::object bytes{};
+  write_string(utf8(value, bytes));
+}
+
+void JSONWriter::write_dict(PyObject* value) {
+  RecursionGuard recursion{};
+  Marker marker{*this, value};
+  nb::ft_object_guard guard{nb::handle{value}};
+  m_out.push_back('{');
+  Py_ssize_t position{0};
+  PyObject* key{nullptr};
+  PyObject* val{nullptr};
+  bool first{true};
+  while (PyDict_Next(value, &position, &key, &val)) {
+    nb::object key_{nb::borrow(key)};
+    nb::object val_{nb::borrow(val)};
+    if (!first) {
+      m_out.push_back(',');
+    }
+    first = false;
+    write_key(key_.ptr());
+    m_out.push_back(':');
+    write(val_);
+  }
+  m_out.push_back('}');
+}
+
+void JSONWriter::write_list(PyObject* value) {
+  RecursionGuard recursion{};
+  Marker marker{*this, value};
+  m_out.push_back('[');
+  for (Py_ssize_t i = 0;; i++) {
+    nb::object item{list_item(value, i)};
+    if (!item.is_valid()) {
+      break;
+    }
+    if (i) {
+      m_out.push_back(',');
+    }
+    write(item);
+  }
+  m_out.push_back(']');
+}
+
+// Like json.dumps, keys that are numbers, bools or None are converted to
+// strings.
+void JSONWriter::write_key(PyObject* key) {
+  if (PyUnicode_Check(key)) {
+    write_str(key);
+    return;
+  }
+
+  if (key == Py_None || PyBool_Check(key) || PyLong_Check(key) ||
+      PyFloat_Check(key)) {
+    JSONWriter writer{};
+    writer.write(key);
+    write_string(writer.m_out);
+    return;
+  }
+
+  nb::handle type{reinterpret_cast<PyObject*>(Py_TYPE(key))};
+  throw nb::type_error(
+      ("keys must be str, int, float, bool or None, not " +
+       nb::cast<std::string>(type.attr("__name__")))
+          .c_str());
+}
+
+void JSONWriter::write_other(nb::handle value) {
+  if (!m_encoder.is_valid()) {
+    auto type{nb::module_::import_("json").attr("JSONEncoder")};
+    auto args{nb::steal(PyTuple_New(0))};
+    auto kwargs{nb::steal(
+        Py_BuildValue("{s:O,s:(ss)}", "ensure_ascii", Py_False, "separators",
+                      ",", ":"))};
+    if (!args.is_valid() || !kwargs.is_valid()) {
+      throw nb::python_error();
+    }
+    m_encoder = nb::steal(PyObject_Call(type.ptr(), args.ptr(), kwargs.ptr()));
+    if (!m_encoder.is_valid()) {
+      throw nb::python_error();
+    }
+  }
+
+  nb::object text{m_encoder.attr("encode")(value)};
+  nb::object bytes{};
+  append_text(m_out, utf8(text.ptr(), bytes), false);
+}
+
+}  // namespace libjsonpath
@@ -0,0 +1,265 @@
+#include "libjsonpath/typed_array.hpp"
+
+#include <cmath>        // std::isfinite std::abs
+#include <cstring>      // std::memcpy
+#include <limits>       // std::numeric_limits
+#include <string>       // std::string std::to_string
+#include <type_traits>  // std::is_integral_v std::is_signed_v
+
+namespace libjsonpath {
+
+namespace {
+
+template <typename T>
+struct Tag {
+  using type = T;
+};
+
+// Call _func_ with a Tag for the C type of the array module's _typecode_.
+// Return false if _typecode_ isn't numeric.
+template <typename Func>
+bool with_type(char typecode, Func&& func) {
+  switch (typecode) {
+    case 'b':
+      func(Tag<signed char>{});
+      return true;
+    case 'B':
+      func(Tag<unsigned char>{});
+      return true;
+    case 'h':
+      func(Tag<short>{});
+      return true;
+    case 'H':
+      func(Tag<unsigned short>{});
+      return true;
+    case 'i':
+      func(Tag<int>{});
+      return true;
+    case 'I':
+      func(Tag<unsigned int>{});
+      return true;
+    case 'l':
+      func(Tag<long>{});
+      return true;
+    case 'L':
+      func(Tag<unsigned long>{});
+      return true;
+    case 'q':
+      func(Tag<long long>{});
+      return true;
+    case 'Q':
+      func(Tag<unsigned long long>{});
+      return true;
+    case 'f':
+      func(Tag<float>{});
+      return true;
+    case 'd':
+      func(Tag<double>{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Return true if the integer _value_ is in range for the integer type T.
+template <typename T, typename V>
+bool fits(V value) {
+  if constexpr (std::is_signed_v<V>) {
+    if (value < 0) {
+      if constexpr (std::is_signed_v<T>) {
+        return value >= std::numeric_limits<T>::min();
+      } else {
+        return false;
+      }
+    }
+  }
+  return static_cast<std::uint64_t>(value) <=
+         static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+}
+
+// Map NumPy style names to type codes with the same size, or return
+// _dtype_'s only character.
+char typecode(std::string_view dtype) {
+  if (dtype.size() == 1) {
+    return dtype[0];
+  }
+
+  if (dtype == "float64") {
+    return 'd';
+  }
+  if (dtype == "float32") {
+    return 'f';
+  }
+
+  bool is_unsigned{dtype.substr(0, 1) == "u"};
+  auto name{is_unsigned ? dtype.substr(1) : dtype};
+  if (name == "int8") {
+    return is_unsigned ? 'B' : 'b';
+  }
+  if (name == "int16") {
+    return is_unsigned ? 'H' : 'h';
+  }
+  if (name == "int32") {
+    return sizeof(int) == 4 ? (is_unsigned ? 'I' : 'i')
+                            : (is_unsigned ? 'L' : 'l');
+  }
+  if (name == "int64") {
+    return is_unsigned ? 'Q' : 'q';
+  }
+  return '\0';
+}
+
+// Return a new array.array of type _typecode_, holding a copy of the
+// _size_ bytes at _data_.
+nb::object make_array(char typecode, const unsigned char* data, size_t size) {
+  // Looked up for every array, like json.JSONEncoder in JSONWriter, rather
+  // than cached in a function local static, whose initialization would hold
+  // a lock while the import runs and might release the GIL.
+  nb::object array{nb::module_::import_("array").attr("array")};
+  nb::object rv{array(std::string(1, typecode))};
+  if (size) {
+    // A memoryview of our buffer, so frombytes is the only copy.
+    auto view{nb::steal(PyMemoryView_FromMemory(
+        reinterpret_cast<char*>(const_cast<unsigned char*>(data)),
+        static_cast<Py_ssize_t>(size), PyBUF_READ))};
+    if (!view.is_valid()) {
+      throw nb::python_error();
+    }
+    rv.attr("frombytes")(view);
+  }
+  return rv;
+}
+
+}  // namespace
+
+TypedArray::TypedArray(std::string_view dtype, bool masked)
+    : m_typecode{typecode(dtype)}, m_itemsize{0}, m_masked{masked} {
+  if (!with_type(m_typecode, [&](auto tag) {
+        m_itemsize = sizeof(typename decltype(tag)::type);
+      })) {
+    throw nb::value_error(
+        ("unsupported array dtype '" + std::string{dtype} + "'").c_str());
+  }
+}
+
+template <typename T>
+void TypedArray::append(T value) {
+  m_data.resize(m_data.size() + sizeof(T));
+  std::memcpy(m_data.data() + m_data.size() - sizeof(T), &value, sizeof(T));
+  if (m_masked) {
+    m_mask.push_back(0);
+  }
+  m_size++;
+}
+
+void TypedArray::reserve(size_t size) {
+  m_data.reserve(size * m_itemsize);
+  if (m_masked) {
+    m_mask.reserve(size);
+  }
+}
+
+void TypedArray::push(nb::handle value) {
+  PyObject* obj{value.ptr()};
+  if (PyFloat_CheckExact(obj)) {
+    push_real(PyFloat_AsDouble(obj));
+    return;
+  }
+
+  if (!PyLong_CheckExact(obj)) {
+    mismatch();
+    return;
+  }
+
+  int overflow{0};
+  long long integer{PyLong_AsLongLongAndOverflow(obj, &overflow)};
+  if (!overflow) {
+    if (integer == -1 && PyErr_Occurred()) {
+      throw nb::python_error();
+    }
+    push_integer(integer);
+    return;
+  }
+
+  // Too big for 64 signed bits.
+  if (real()) {
+    double rv{PyLong_AsDouble(obj)};
+    if (rv == -1.0 && PyErr_Occurred()) {
+      PyErr_Clear();
+      mismatch();
+      return;
+    }
+    push_real(rv);
+  } else if (overflow > 0) {
+    unsigned long long rv{PyLong_AsUnsignedLongLong(obj)};
+    if (rv == static_cast<unsigned long long>(-1) && PyErr_Occurred()) {
+      PyErr_Clear();
+      mismatch();
+      return;
+    }
+    push_unsigned(rv);
+  } else {
+    mismatch();
+  }
+}
+
+void TypedArray::push_integer(std::int64_t value) {
+  with_type(m_typecode, [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    if constexpr (std::is_integral_v<T>) {
+      if (!fits<T>(value)) {
+        mismatch();
+        return;
+      }
+    }
+    append<T>(static_cast<T>(value));
+  });
+}
+
+void TypedArray::push_unsigned(std::uint64_t value) {
+  with_type(m_typecode, [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    if constexpr (std::is_integral_v<T>) {
+      if (!fits<T>(value)) {
+        mismatch();
+        return;
+      }
+    }
+    append<T>(static_cast<T>(value));
+  });
+}
+
+void TypedArray::push_real(double value) {
+  if (m_typecode == 'd') {
+    append<double>(value);
+  } else if (m_typecode == 'f' &&
+             (!std::isfinite(value) ||
+              std::abs(value) <= std::numeric_limits<float>::max())) {
+    append<float>(static_cast<float>(value));
+  } else {
+    mismatch();
+  }
+}
+
+nb::object TypedArray::to_python() const {
+  nb::object rv{make_array(m_typecode, m_data.data(), m_data.size())};
+  if (!m_masked) {
+    return rv;
+  }
+  nb::object mask{make_array('B', m_mask.data(), m_mask.size())};
+  return nb::make_tuple(rv, mask);
+}
+
+void TypedArray::mismatch() {
+  if (!m_masked) {
+    throw nb::type_error(("value " + std::to_string(m_size) +
+                          " can't be stored in an array of type '" +
+                          std::string(1, m_typecode) + "'")
+                             .c_str());
+  }
+  m_data.resize(m_data.size() + m_itemsize, 0);
+  m_mask.push_back(1);
+  m_size++;
+}
+
+}  // namespace libjsonpath
@@ -0,0 +1,56 @@
+import jsonpath24
+
+
+def test_repeated_queries_hit_the_cache() -> None:
+    """Test that we reuse parsed queries."""
+    env = jsonpath24.JSONPathEnvironment()
+    data = {"a": [1, 2, 3]}
+    assert env.findall("$.a[*]", data) == [1, 2, 3]
+    assert env.findall("$.a[*]", data) == [1, 2, 3]
+    assert env.findall("$.a[0]", data) == [1]
+
+    info = env.cache_info()
+    assert info.hits == 1
+    assert info.misses == 2  # noqa: PLR2004
+    assert info.evictions == 0
+    assert info.currsize == 2  # noqa: PLR2004
+
+
+def test_least_recently_used_queries_are_evicted() -> None:
+    """Test that we evict the least recently used query when the cache is full."""
+    env = jsonpath24.JSONPathEnvironment(cache_size=2)
+    data = {"a": 1, "b": 2, "c": 3}
+    env.query("$.a", data)
+    env.query("$.b", data)
+    env.query("$.a", data)
+    env.query("$.c", data)  # evicts $.b
+
+    info = env.cache_info()
+    assert info.evictions == 1
+    assert info.currsize == 2  # noqa: PLR2004
+
+    env.query("$.a", data)
+    assert env.cache_info().hits == 2  # noqa: PLR2004
+    env.query("$.b", data)
+    assert env.cache_info().misses == 4  # noqa: PLR2004
+
+
+def test_clear_cache() -> None:
+    """Test that we can empty the query cache."""
+    env = jsonpath24.JSONPathEnvironment()
+    env.query("$.a", {"a": 1})
+    env.cache_clear()
+    info = env.cache_info()
+    assert info.currsize == 0
+    assert info.misses == 0
+
+
+def test_disable_cache() -> None:
+    """Test that a cache size of zero disables query caching."""
+    env = jsonpath24.JSONPathEnvironment(cache_size=0)
+    assert env.findall("$.a", {"a": 1}) == [1]
+    assert env.findall("$.a", {"a": 1}) == [1]
+    info = env.cache_info()
+    assert info.hits == 0
+    assert info.currsize == 0
+    assert info.maxsize == 0
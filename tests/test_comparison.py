@@ -0,0 +1,34 @@
+from jsonpath24 import JSONPathEnvironment
+
+
+class Text(str):
+    def __lt__(self, other: object) -> bool:
+        return True
+
+
+def test_numeric_comparison() -> None:
+    """Test comparisons between ints, floats and big ints."""
+    env = JSONPathEnvironment()
+    data = [1, 1.0, 2**70, float(2**70), 2**53 + 1, 1.5, "1"]
+    assert env.findall("$[?@ == 1]", data) == [1, 1.0]
+    assert env.findall("$[?@ > 2]", data) == [2**70, float(2**70), 2**53 + 1]
+    assert env.findall("$[?@ < 1.5]", data) == [1, 1.0]
+    assert env.findall("$[?@ == 9007199254740993]", data) == [2**53 + 1]
+
+
+def test_deep_equality() -> None:
+    """Test that arrays and objects are compared by value."""
+    env = JSONPathEnvironment()
+    data = {
+        "a": {"x": [1, {"y": "é"}], "z": None},
+        "b": {"z": None, "x": [1.0, {"y": "é"}]},
+        "c": {"x": [1, {"y": "e"}], "z": None},
+    }
+    assert env.findall("$[?@ == $.a]", data) == [data["a"], data["b"]]
+    assert env.findall("$[?@.x != $.a.x]", data) == [data["c"]]
+
+
+def test_subclasses_use_python_comparison() -> None:
+    """Test that instances of subclasses are compared by Python."""
+    env = JSONPathEnvironment()
+    assert env.findall("$[?@ < 'a']", [Text("z"), "z"]) == ["z"]
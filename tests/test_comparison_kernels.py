@@ -0,0 +1,75 @@
+import json
+import math
+from typing import Any
+from typing import List
+
+import pytest
+
+from jsonpath24 import JSONDocument
+from jsonpath24 import JSONPathEnvironment
+
+ARRAYS = {
+    "integers": [i % 11 - 5 for i in range(200)],
+    "big integers": [2**53, 2**53 + 1, -(2**53) - 1, 2**63 - 1, -(2**63), 3] * 20,
+    "floats": [0.0, -0.0, 1.5, -2.25, 3.0, math.inf, -math.inf, 1e300] * 20,
+    "nan": [1.0, math.nan, 2.5, math.nan] * 30,
+    "mixed": [1, 2, 3.0, 2.5, -1] * 30,
+    "strings": ["", "a", "ab", "abc", "b", "é", "z" * 16, "ÿ", "\U0001f600"] * 20,
+    "long strings": ["ab", "z" * 17] * 50,
+    "bools": [1, True, 0, False] * 30,
+    "short": [1, 2, 3],
+}
+
+FILTERS = [
+    "@ == 3",
+    "@ != 3",
+    "@ < 2.5",
+    "@ <= 3.0",
+    "@ > -1",
+    "@ >= 9007199254740992",
+    "@ == 9007199254740993",
+    "@ < 99999999999999999999",
+    "@ > 1e400",
+    "@ == 'ab'",
+    "@ < 'b'",
+    "@ >= 'é'",
+    "@ > 'zzzzzzzzzzzzzzzz'",
+    "@ != 'zzzzzzzzzzzzzzzzz'",
+    "@ == true",
+    "3 > @",
+    "'ab' <= @",
+]
+
+
+def expected(env: JSONPathEnvironment, data: List[Any], filter_: str) -> List[Any]:
+    # `@.v` isn't a bare current node, so it is never compared by a kernel.
+    wrapped = [{"v": item} for item in data]
+    query = f"$[?{filter_.replace('@', '@.v')}].v"
+    return env.findall(query, wrapped)
+
+
+@pytest.mark.parametrize("name", ARRAYS)
+@pytest.mark.parametrize("filter_", FILTERS)
+def test_comparison_kernels(name: str, filter_: str) -> None:
+    """Test that literal comparisons agree with comparing one item at a time."""
+    env = JSONPathEnvironment()
+    data = ARRAYS[name]
+    want = expected(env, data, filter_)
+    query = f"$[?{filter_}]"
+    assert env.findall(query, data) == want
+
+    doc = JSONDocument(json.dumps(data))
+    assert env.findall(query, doc) == want
+
+    env = JSONPathEnvironment(parallel_threshold=50, threads=2)
+    assert env.findall(query, doc) == want
+
+
+def test_comparison_kernel_locations() -> None:
+    """Test that nodes selected by a kernel have the right locations."""
+    env = JSONPathEnvironment()
+    data = {"a": list(range(100))}
+    nodes = env.query("$.a[?@ > 97]", data)
+    assert [node.path() for node in nodes] == ["$['a'][98]", "$['a'][99]"]
+    nodes = env.query("$.a[?@ > 97]", JSONDocument(json.dumps(data)))
+    assert [node.path() for node in nodes] == ["$['a'][98]", "$['a'][99]"]
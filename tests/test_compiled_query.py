@@ -0,0 +1,39 @@
+import jsonpath24
+
+
+def test_compiled_query() -> None:
+    """Test that we can reuse a compiled query."""
+    path = jsonpath24.compile("$.a[?@ > 1]")
+    assert path.findall({"a": [1, 2, 3]}) == [2, 3]
+    assert path.findall({"a": [4]}) == [4]
+    assert [node.path() for node in path.query({"a": [1, 2]})] == ["$['a'][1]"]
+
+
+def test_compiled_query_to_string() -> None:
+    """Test that we can get the canonical string form of a compiled query."""
+    path = jsonpath24.compile("$.foo.bar")
+    assert str(path) == "$['foo']['bar']"
+
+
+def test_compiled_query_segments() -> None:
+    """Test that we can inspect a compiled query's syntax tree."""
+    path = jsonpath24.compile("$.foo[0]")
+    segments = path.segments
+    assert jsonpath24.to_string(segments) == "$['foo'][0]"
+    assert path.segments is segments
+
+
+def test_compiled_query_outlives_environment() -> None:
+    """Test that a compiled query keeps its environment alive."""
+    path = jsonpath24.JSONPathEnvironment().compile("$.a")
+    assert path.findall({"a": 1}) == [1]
+
+
+def test_compiled_query_from_segments() -> None:
+    """Test that JSONPath still accepts parsed segments."""
+    env = jsonpath24.JSONPathEnvironment()
+    segments = env._env.parse("$.a[?@ > 1]")  # noqa: SLF001
+    path = jsonpath24.JSONPath(env, segments)
+    assert path.findall({"a": [1, 2, 3]}) == [2, 3]
+    assert str(path) == jsonpath24.to_string(segments)
+    assert path.segments is segments
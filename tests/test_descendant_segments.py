@@ -0,0 +1,28 @@
+import jsonpath24
+
+DATA = {
+    "a": {
+        "a": {"b": 1, "a": {"b": 2}},
+        "b": 3,
+        "c": [{"a": {"b": 4}}, {"b": 5}],
+    },
+    "b": [6, {"a": 7}],
+}
+
+
+def test_multiple_descendant_segments() -> None:
+    """Test that nodes reachable more than once are repeated, in order."""
+    assert jsonpath24.findall("$..a..b", DATA) == [3, 1, 2, 4, 5, 1, 2, 2, 4]
+
+
+def test_multiple_descendant_segments_locations() -> None:
+    """Test that node locations follow segment by segment evaluation."""
+    assert [node.path() for node in jsonpath24.query("$..a..b", DATA)] == [
+        node.path() for node in jsonpath24.finditer("$..a..b", DATA)
+    ]
+
+
+def test_multiple_descendant_segments_with_child_segments() -> None:
+    """Test a mix of child and descendant segments."""
+    assert jsonpath24.findall("$..c[*]..a.b", DATA) == [4]
+    assert jsonpath24.findall("$..[0,1]..b", {"x": [{"b": 1}, {"b": 2}]}) == [1, 2]
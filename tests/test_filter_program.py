@@ -0,0 +1,28 @@
+import jsonpath24
+
+
+def test_compiled_filter() -> None:
+    """Test that a compiled filter is reused for every candidate."""
+    data = [
+        {"price": 8, "category": "fiction"},
+        {"price": 12, "category": "fiction"},
+        {"price": 9, "category": "reference"},
+    ]
+    path = jsonpath24.compile("$[?@.price < 10 && @.category == 'fiction']")
+    assert path.findall(data) == [data[0]]
+    assert path.findall(data[1:]) == []
+
+
+def test_constant_sub_expressions() -> None:
+    """Test filters with sub-expressions made only of literals."""
+    data = [1, 2, 3]
+    assert jsonpath24.findall("$[?1 == 1]", data) == data
+    assert jsonpath24.findall("$[?1 == 2]", data) == []
+    assert jsonpath24.findall("$[?'a' < 'b' && @ > 1]", data) == [2, 3]
+    assert jsonpath24.findall("$[?!(1 == 2) && @ != 2]", data) == [1, 3]
+
+
+def test_nested_filters() -> None:
+    """Test that filters in filter queries are compiled too."""
+    data = {"a": [{"b": [1, 5]}, {"b": [2]}]}
+    assert jsonpath24.findall("$.a[?@.b[?@ > 4]]", data) == [{"b": [1, 5]}]
@@ -0,0 +1,27 @@
+import pytest
+
+import jsonpath24
+
+
+def test_findall() -> None:
+    """Test that `findall` returns values only."""
+    data = {"a": [{"b": 1}, {"b": 2}, {"c": 3}]}
+    assert jsonpath24.findall("$.a[*].b", data) == [1, 2]
+
+
+def test_findall_matches_query() -> None:
+    """Test that `findall` produces values in the same order as `query`."""
+    data = {"a": {"a": {"b": 1}, "b": [2, {"a": {"b": 3}}]}, "c": [1, 2, 3]}
+    for path in ("$..a..b", "$..*", "$.c[::-1]", "$..[?@.b]"):
+        assert jsonpath24.findall(path, data) == [
+            node.value for node in jsonpath24.query(path, data)
+        ]
+        assert jsonpath24.compile(path).findall(data) == jsonpath24.findall(
+            path, data
+        )
+
+
+def test_findall_non_string_keys() -> None:
+    """Test that `findall` rejects mappings with non-string keys."""
+    with pytest.raises(TypeError):
+        jsonpath24.findall("$.*", {1: "a"})
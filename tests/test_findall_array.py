@@ -0,0 +1,82 @@
+import json
+import math
+from array import array
+from typing import List
+
+import pytest
+
+from jsonpath24 import JSONDocument
+from jsonpath24 import JSONPathEnvironment
+from jsonpath24 import compile
+from jsonpath24 import findall_array
+
+DATA = {"rows": [{"price": 1.5}, {"price": 2}, {"price": -3.25}, {"price": 1e300}]}
+
+MIXED = [1, 2.5, -3, 2**63, 300, True, None, "x", math.inf, [1]]
+
+MASKED = [
+    ("d", [1, 2.5, -3, 2.0**63, 300, 0, 0, 0, math.inf, 0], [0, 0, 0, 0, 0, 1, 1, 1, 0, 1]),
+    ("int64", [1, 0, -3, 0, 300, 0, 0, 0, 0, 0], [0, 1, 0, 1, 0, 1, 1, 1, 1, 1]),
+    ("Q", [1, 0, 0, 2**63, 300, 0, 0, 0, 0, 0], [0, 1, 1, 0, 0, 1, 1, 1, 1, 1]),
+    ("b", [1, 0, -3, 0, 0, 0, 0, 0, 0, 0], [0, 1, 0, 1, 1, 1, 1, 1, 1, 1]),
+]  # fmt: skip
+
+
+def data(obj: object, *, document: bool) -> object:
+    return JSONDocument(json.dumps(obj)) if document else obj
+
+
+@pytest.mark.parametrize("document", [False, True])
+def test_float64(document: bool) -> None:  # noqa: FBT001
+    """Test that matching numbers are written to a double array."""
+    rv = findall_array("$.rows[*].price", data(DATA, document=document))
+    assert isinstance(rv, array)
+    assert rv.typecode == "d"
+    assert rv.tolist() == [1.5, 2.0, -3.25, 1e300]
+    assert memoryview(rv).format == "d"
+
+
+@pytest.mark.parametrize("document", [False, True])
+def test_compiled_query(document: bool) -> None:  # noqa: FBT001
+    """Test that compiled queries have findall_array too."""
+    path = compile("$.rows[*].price")
+    rv = path.findall_array(data(DATA, document=document), "float32", masked=True)
+    assert isinstance(rv, tuple)
+    values, mask = rv
+    assert values.typecode == "f"
+    assert values.tolist() == [1.5, 2.0, -3.25, 0.0]
+    assert mask.tolist() == [0, 0, 0, 1]
+
+    # 1e300 is too big for a float.
+    with pytest.raises(TypeError, match="value 3 "):
+        path.findall_array(data(DATA, document=document), "float32")
+
+
+@pytest.mark.parametrize("document", [False, True])
+@pytest.mark.parametrize(("dtype", "want", "mask"), MASKED)
+def test_masked(
+    document: bool,  # noqa: FBT001
+    dtype: str,
+    want: List[object],
+    mask: List[int],
+) -> None:
+    """Test that values that don't fit are stored as zero and masked."""
+    rv = findall_array("$[*]", data(MIXED, document=document), dtype, masked=True)
+    assert isinstance(rv, tuple)
+    values, got_mask = rv
+    assert values.tolist() == want
+    assert got_mask.typecode == "B"
+    assert got_mask.tolist() == mask
+
+
+@pytest.mark.parametrize("document", [False, True])
+def test_mismatch(document: bool) -> None:  # noqa: FBT001
+    """Test that values that don't fit raise a TypeError if not masked."""
+    with pytest.raises(TypeError, match="value 1 "):
+        findall_array("$[*]", data(MIXED, document=document), "q")
+
+
+def test_unsupported_dtype() -> None:
+    """Test that unknown types are rejected."""
+    with pytest.raises(ValueError, match="unsupported"):
+        JSONPathEnvironment().findall_array("$[*]", [1], "u")
@@ -0,0 +1,31 @@
+import jsonpath24
+
+
+def test_finditer() -> None:
+    """Test that we can iterate nodes lazily."""
+    data = {"a": [{"b": 1}, {"b": 2}, {"c": 3}]}
+    nodes = jsonpath24.finditer("$.a[*].b", data)
+    assert [node.value for node in nodes] == [1, 2]
+
+
+def test_finditer_matches_query() -> None:
+    """Test that lazy iteration produces nodes in the same order as `query`."""
+    data = {"a": {"a": {"b": 1}, "b": [2, {"a": {"b": 3}}]}}
+    query = "$..a..b"
+    assert [node.path() for node in jsonpath24.finditer(query, data)] == [
+        node.path() for node in jsonpath24.query(query, data)
+    ]
+
+
+def test_finditer_is_lazy() -> None:
+    """Test that we can stop iterating early."""
+    data = {"a": list(range(100))}
+    it = jsonpath24.compile("$.a[?@ > 10]").finditer(data)
+    assert next(it).value == 11  # noqa: PLR2004
+    assert next(it).value == 12  # noqa: PLR2004
+
+
+def test_finditer_empty_query() -> None:
+    """Test that the root query yields the root node."""
+    data = {"a": 1}
+    assert [node.value for node in jsonpath24.finditer("$", data)] == [data]
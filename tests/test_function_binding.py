@@ -0,0 +1,47 @@
+import pytest
+
+from jsonpath24 import ExpressionType
+from jsonpath24 import FilterFunction
+from jsonpath24 import JSONPathEnvironment
+from jsonpath24 import JSONPathTypeError
+
+
+class Double(FilterFunction):
+    arg_types = (ExpressionType.value,)
+    return_type = ExpressionType.value
+
+    def __call__(self, obj: object) -> object:
+        return obj * 2 if isinstance(obj, int) else None
+
+
+class NotNodes(FilterFunction):
+    arg_types = (ExpressionType.value,)
+    return_type = ExpressionType.nodes
+
+    def __call__(self, obj: object) -> object:
+        return obj
+
+
+def test_bound_function_calls() -> None:
+    """Test that compiled queries call the functions they were compiled with."""
+    env = JSONPathEnvironment()
+    env.register_function("double", Double())
+    path = env.compile("$[?double(@) > 4 || length(@) == 0]")
+    assert path.findall([1, 2, 3, 4, "", "ab"]) == [3, 4, ""]
+    assert path.findall([5, [], [1]]) == [5, []]
+
+
+def test_standard_functions_in_filters() -> None:
+    """Test `count` and `length` over many candidate nodes."""
+    env = JSONPathEnvironment()
+    data = [{"a": list(range(i % 5))} for i in range(100)]
+    assert len(env.findall("$[?count(@.a.*) > 2]", data)) == 40  # noqa: PLR2004
+    assert len(env.findall("$[?length(@.a) == 0]", data)) == 20  # noqa: PLR2004
+
+
+def test_nodes_function_returns_something_else() -> None:
+    """Test that a nodes function returning a non node list is a type error."""
+    env = JSONPathEnvironment()
+    env.register_function("notnodes", NotNodes())
+    with pytest.raises(JSONPathTypeError, match="must return a list of nodes"):
+        env.findall("$[?count(notnodes(@)) > 0]", [1, 2])
@@ -0,0 +1,61 @@
+import pytest
+from jsonpath24 import JSONPathEnvironment
+from jsonpath24.functions import Match
+from jsonpath24.functions import Search
+
+DATA = ["ab", "aab", "^ab$", "x\ry", "x\ny", "xay", "Ж", "ж1", 1, None]
+
+CASES = [
+    ("$[?match(@, 'a+b')]", ["ab", "aab"]),
+    ("$[?search(@, 'a{2}')]", ["aab"]),
+    ("$[?match(@, '^ab$')]", ["^ab$"]),
+    ("$[?match(@, 'x.y')]", ["xay"]),
+    ("$[?match(@, '\\\\p{Lu}')]", ["Ж"]),
+    ("$[?search(@, '\\\\P{L}')]", ["^ab$", "x\ry", "x\ny", "ж1"]),
+    ("$[?search(@, '[\\\\p{Nd}\\\\p{Sm}]')]", ["ж1"]),
+    ("$[?match(@, '\\\\d')]", []),
+    ("$[?search(@, 'a**')]", []),
+]
+
+
+@pytest.mark.parametrize(("query", "want"), CASES)
+def test_iregexp_literal_patterns(query: str, want: object) -> None:
+    """Test that native `match` and `search` follow I-Regexp semantics."""
+    env = JSONPathEnvironment()
+    assert env.findall(query, DATA) == want
+
+
+def test_iregexp_dynamic_patterns() -> None:
+    """Test patterns that come from the data being queried."""
+    env = JSONPathEnvironment()
+    data = [
+        {"s": "abc", "p": "[a-c]+"},
+        {"s": "abc", "p": "b"},
+        {"s": "abc", "p": "(a"},
+        {"s": "abc", "p": 1},
+    ]
+    assert env.findall("$[?match(@.s, @.p)].p", data) == ["[a-c]+"]
+    assert env.findall("$[?search(@.s, @.p)].p", data) == ["[a-c]+", "b"]
+
+
+def test_no_catastrophic_backtracking() -> None:
+    """Test that nested quantifiers match in linear time."""
+    env = JSONPathEnvironment()
+    assert env.findall("$[?match(@, '(a+)+b')]", ["a" * 10000]) == []
+
+
+def test_subclasses_agree_with_native() -> None:
+    """Test that subclasses called from Python match like native functions."""
+
+    class MyMatch(Match):
+        pass
+
+    class MySearch(Search):
+        pass
+
+    native = JSONPathEnvironment()
+    env = JSONPathEnvironment()
+    env.register_function("match", MyMatch())
+    env.register_function("search", MySearch())
+    for query, _ in CASES:
+        assert env.findall(query, DATA) == native.findall(query, DATA), query
@@ -0,0 +1,79 @@
+import json
+from typing import Union
+
+import pytest
+
+from jsonpath24 import JSONDocument
+from jsonpath24 import JSONDocumentError
+from jsonpath24 import JSONPathEnvironment
+
+DATA = {
+    "meta": {"id": 7, "tags": ["a", "b"]},
+    "items": [{"price": 1.5}, {"price": 5}, {"price": 3, "name": "café"}],
+    "big": 123456789012345678901234567890,
+}
+
+
+def test_query_json_document() -> None:
+    """Test that querying a parsed document matches querying decoded data."""
+    env = JSONPathEnvironment()
+    doc = JSONDocument(json.dumps(DATA))
+    for path in [
+        "$.meta.id",
+        "$.meta.*",
+        "$..price",
+        "$.items[?@.price > 2].name",
+        "$.items[-1:0:-1]",
+        "$..[?@ == $.meta.id]",
+        "$.big",
+    ]:
+        assert env.findall(path, doc) == env.findall(path, DATA)
+        assert [node.path() for node in env.query(path, doc)] == [
+            node.path() for node in env.query(path, DATA)
+        ]
+
+
+def test_json_document_input_types() -> None:
+    """Test that documents can be parsed from str and bytes-like objects."""
+    text = '{"a": [1, "\\u00e9\\ud83d\\ude00", null, true]}'
+    data = json.loads(text)
+    assert JSONDocument(text).value() == data
+    assert JSONDocument(text.encode()).value() == data
+    assert JSONDocument(memoryview(text.encode())).value() == data
+    assert JSONDocument(bytearray(b"\xef\xbb\xbf[1]")).value() == [1]
+
+
+def test_json_document_compiled_query() -> None:
+    """Test that compiled queries accept parsed documents."""
+    path = JSONPathEnvironment().compile("$.a[*]")
+    assert path.findall(JSONDocument(b'{"a": [1, 2.5, "x"]}')) == [1, 2.5, "x"]
+
+
+def test_json_document_matches_json_loads() -> None:
+    """Test that values are decoded like json.loads decodes them."""
+    text = '[NaN, -Infinity, 1e400, -0, 1E-2, "\\ud800", {"a": 1, "a": 2}]'
+    value = JSONDocument(text).value()
+    assert repr(value) == repr(json.loads(text))
+
+
+def test_repeated_keys() -> None:
+    """Test that the last value of a repeated key is selected."""
+    env = JSONPathEnvironment()
+    doc = JSONDocument('{"a": 1, "b": 2, "a": 3}')
+    assert env.findall("$.a", doc) == [3]
+    assert env.findall("$.*", doc) == [3, 2]
+
+
+@pytest.mark.parametrize(
+    "text", ["", "[1,]", "{'a': 1}", "[1] 2", '"\\x"', "01", b"[\xff]"]
+)
+def test_invalid_json(text: Union[str, bytes]) -> None:
+    """Test that invalid JSON raises a ValueError."""
+    with pytest.raises(JSONDocumentError):
+        JSONDocument(text)
+
+
+def test_not_json_text() -> None:
+    """Test that we only parse str and bytes-like objects."""
+    with pytest.raises(TypeError):
+        JSONDocument(1)  # type: ignore
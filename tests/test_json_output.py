@@ -0,0 +1,100 @@
+import json
+import math
+from collections import OrderedDict
+from typing import Any
+from typing import List
+
+import pytest
+
+from jsonpath24 import JSONDocument
+from jsonpath24 import JSONPathEnvironment
+from jsonpath24 import compile
+from jsonpath24 import findall_json
+from jsonpath24 import query_json
+
+DATA = {
+    "a": [1, -2**70, 1.5, 1e16, 1e15, 1e-05, 0.0001, -0.0, 0.1, 1 / 3],
+    "b": {"x\n": "é😀", "y": '"quoted" \\ \t \x01 \x7f', "z": [None, True, False]},
+    "c": [math.nan, math.inf, -math.inf],
+}
+
+QUERIES = ["$", "$.a[*]", "$..*", "$.b", "$.nosuchthing"]
+
+
+def dumps(obj: Any) -> bytes:  # noqa: ANN401
+    return json.dumps(obj, ensure_ascii=False, separators=(",", ":")).encode()
+
+
+@pytest.mark.parametrize("query", QUERIES)
+def test_findall_json(query: str) -> None:
+    """Test that values are written like json.dumps would write them."""
+    env = JSONPathEnvironment()
+    want = dumps(env.findall(query, DATA))
+    assert env.findall_json(query, DATA) == want
+    assert env.findall_json(query, JSONDocument(json.dumps(DATA))) == want
+    assert compile(query).findall_json(DATA) == want
+
+
+@pytest.mark.parametrize("query", QUERIES)
+def test_query_json(query: str) -> None:
+    """Test that nodes are written with their normalized paths."""
+    env = JSONPathEnvironment()
+    nodes = env.query(query, DATA)
+    want = dumps([{"path": node.path(), "value": node.value} for node in nodes])
+    assert env.query_json(query, DATA) == want
+    assert env.query_json(query, JSONDocument(json.dumps(DATA))) == want
+    assert compile(query).query_json(DATA) == want
+
+
+def test_other_types() -> None:
+    """Test that other types are written like json.dumps would write them."""
+    data = {"t": (1, 2), "o": OrderedDict(k=1), 1: "int key", None: 2.5}
+    assert findall_json("$", data) == dumps([data])
+
+
+def test_not_serializable() -> None:
+    """Test that values json.dumps can't write raise a TypeError."""
+    with pytest.raises(TypeError):
+        findall_json("$", {"a": object()})
+    with pytest.raises(TypeError, match="keys must be"):
+        findall_json("$", [{(1, 2): 1}])
+
+
+def test_lone_surrogates() -> None:
+    """Test that lone surrogates are escaped so the result is valid UTF-8."""
+    rv = query_json("$[0]", ["\ud800"])
+    assert rv == b'[{"path":"$[0]","value":"\\ud800"}]'
+    assert json.loads(rv.decode())[0]["value"] == "\ud800"
+
+
+def test_circular_reference() -> None:
+    """Test that circular data raises ValueError, like json.dumps."""
+    data: List[Any] = []
+    data.append({"a": data})
+    with pytest.raises(ValueError, match="Circular reference detected"):
+        findall_json("$", data)
+
+
+def test_repeated_values() -> None:
+    """Test that values that appear more than once aren't circular."""
+    shared = [1]
+    assert findall_json("$", [shared, {"a": shared}]) == b'[[[1],{"a":[1]}]]'
+
+
+def test_deep_nesting() -> None:
+    """Test that deeply nested data raises RecursionError, like json.dumps."""
+    data: List[Any] = []
+    for _ in range(100000):
+        data = [data]
+    with pytest.raises(RecursionError):
+        findall_json("$", data)
+
+
+def test_escaped_names() -> None:
+    """Test that names are escaped in paths, as in normalized paths."""
+    data = {"a'b\\c\nd\x01é": 1}
+    path = "$['a\\'b\\\\c\\nd\\u0001é']"
+    assert query_json("$.*", data) == dumps([{"path": path, "value": 1}])
+    assert query_json("$.*", JSONDocument(json.dumps(data))) == dumps(
+        [{"path": path, "value": 1}]
+    )
@@ -0,0 +1,48 @@
+from typing import List
+from typing import Sized
+
+from jsonpath24 import JSONPathEnvironment
+from jsonpath24.functions import Count
+from jsonpath24.functions import Length
+
+
+def test_native_standard_functions() -> None:
+    """Test native `count`, `length` and `value` implementations."""
+    env = JSONPathEnvironment()
+    data = [
+        {"name": "a", "tags": ["x", "y", "z"]},
+        {"name": "a" * 30, "tags": ["x", "y", "z"]},
+        {"name": "b", "tags": ["x"]},
+        {"name": 1, "tags": {"p": 1, "q": 2, "r": 3}},
+    ]
+    assert env.findall(
+        "$[?count(@.tags[*]) > 2 && length(@.name) < 20].name", data
+    ) == ["a"]
+    assert env.findall("$[?length(@.name) == 1].name", data) == ["a", "b"]
+    assert env.findall("$[?value(@.tags[*]) == 'x'].name", data) == ["b"]
+    assert env.findall("$[?count(@..*) == 3].name", data) == ["b"]
+
+
+def test_python_function_overrides_native() -> None:
+    """Test that a Python function registered with a standard name wins."""
+    calls: List[int] = []
+
+    class MyCount(Count):
+        def __call__(self, node_list: Sized) -> int:
+            calls.append(len(node_list))
+            return 0
+
+    env = JSONPathEnvironment()
+    env.register_function("count", MyCount())
+    assert env.findall("$[?count(@.*) == 0]", [[1, 2], [3]]) == [[1, 2], [3]]
+    assert calls == [2, 1]
+
+
+def test_native_function_registered_under_another_name() -> None:
+    """Test that native implementations follow the callable, not its name."""
+    env = JSONPathEnvironment()
+    env.register_function("size", Length())
+    assert env.findall("$[?size(@) == 2]", ["ab", [1, 2], "abc", 2]) == [
+        "ab",
+        [1, 2],
+    ]
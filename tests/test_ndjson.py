@@ -0,0 +1,84 @@
+import json
+from pathlib import Path
+
+import pytest
+
+import jsonpath24
+from jsonpath24 import JSONDocumentError
+from jsonpath24 import JSONPathEnvironment
+
+RECORDS = [{"id": i, "tags": ["x"] * (i % 3), "n": i * 1.5} for i in range(1, 2001)]
+
+
+@pytest.fixture()
+def ndjson_file(tmp_path: Path) -> Path:
+    path = tmp_path / "data.ndjson"
+    path.write_text("".join(json.dumps(record) + "\n" for record in RECORDS))
+    return path
+
+
+def test_findall_ndjson(ndjson_file: Path) -> None:
+    """Test that each line is queried, in file order, with line numbers."""
+    results = list(jsonpath24.findall_ndjson("$.id", ndjson_file))
+    assert results == [(i, [i]) for i in range(1, 2001)]
+
+
+def test_lines_without_matches_are_skipped(ndjson_file: Path) -> None:
+    """Test that lines with no matches are not yielded."""
+    results = list(jsonpath24.findall_ndjson("$.tags[1]", ndjson_file))
+    assert [line for line, _ in results] == [i for i in range(1, 2001) if i % 3 == 2]
+
+
+def test_query_ndjson_with_filter(ndjson_file: Path) -> None:
+    """Test that filter queries produce nodes with locations."""
+    env = JSONPathEnvironment()
+    results = list(env.query_ndjson("$[?@ > 2998]", ndjson_file, threads=2))
+    assert [line for line, _ in results] == [1999, 2000]
+    assert [node.path() for node in results[-1][1]] == ["$['n']"]
+    assert [node.value for node in results[-1][1]] == [3000.0]
+
+
+def test_root_query_in_filter(tmp_path: Path) -> None:
+    """Test that root queries in filters see the current line."""
+    path = tmp_path / "data.ndjson"
+    path.write_text('{"a": [1, 2], "b": 2}\n{"a": [1, 2], "b": 1}\n')
+    results = list(jsonpath24.findall_ndjson("$.a[?@ == $.b]", path))
+    assert results == [(1, [2]), (2, [1])]
+
+
+def test_unordered(ndjson_file: Path) -> None:
+    """Test that unordered results include every line exactly once."""
+    query = jsonpath24.compile("$.n")
+    results = list(query.findall_ndjson(ndjson_file, threads=4, ordered=False))
+    assert sorted(results) == [(i, [i * 1.5]) for i in range(1, 2001)]
+
+
+def test_blank_lines_and_crlf(tmp_path: Path) -> None:
+    """Test that blank lines are skipped and line numbers still count them."""
+    path = tmp_path / "data.ndjson"
+    path.write_bytes(b'{"a": 1}\r\n\r\n  \n{"a": 2}')
+    assert list(jsonpath24.findall_ndjson("$.a", path)) == [(1, [1]), (4, [2])]
+
+
+def test_empty_file(tmp_path: Path) -> None:
+    """Test that an empty file yields nothing."""
+    path = tmp_path / "empty.ndjson"
+    path.write_bytes(b"")
+    assert list(jsonpath24.findall_ndjson("$.a", path)) == []
+
+
+def test_invalid_line(tmp_path: Path) -> None:
+    """Test that an invalid line raises after earlier lines are yielded."""
+    path = tmp_path / "data.ndjson"
+    path.write_text('{"a": 1}\n{"a": 2}\n{"a": \n{"a": 4}\n')
+    results = []
+    with pytest.raises(JSONDocumentError, match="line 3"):
+        for result in jsonpath24.findall_ndjson("$.a", path, threads=1):
+            results.append(result)  # noqa: PERF402
+    assert results == [(1, [1]), (2, [2])]
+
+
+def test_missing_file(tmp_path: Path) -> None:
+    """Test that a missing file raises an OSError."""
+    with pytest.raises(FileNotFoundError):
+        jsonpath24.findall_ndjson("$.a", tmp_path / "nope.ndjson")
@@ -0,0 +1,31 @@
+import pytest
+from jsonpath24 import ExpressionType
+from jsonpath24 import FilterFunction
+from jsonpath24 import JSONPathEnvironment
+
+
+class Fail(FilterFunction):
+    arg_types = (ExpressionType.value,)
+    return_type = ExpressionType.logical
+
+    def __call__(self, obj: object) -> bool:
+        if obj == 3:  # noqa: PLR2004
+            raise ValueError("oops")
+        return True
+
+
+def test_reused_buffers_after_error() -> None:
+    """Test that queries after a failed query start with empty node lists."""
+    env = JSONPathEnvironment()
+    env.register_function("fail", Fail())
+    data = {"a": [{"b": i} for i in range(5)]}
+
+    with pytest.raises(ValueError, match="oops"):
+        env.findall("$.a[?fail(@.b)].b", data)
+
+    for _ in range(3):
+        assert env.findall("$.a[?@.b < 3 && fail(@.b)].b", data) == [0, 1, 2]
+        assert env.findall("$.a[*].b", data) == [0, 1, 2, 3, 4]
+        assert [node.path() for node in env.query("$..b", data)] == [
+            f"$['a'][{i}]['b']" for i in range(5)
+        ]
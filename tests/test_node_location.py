@@ -0,0 +1,26 @@
+import jsonpath24
+
+
+def test_node_location() -> None:
+    """Test that nodes build their location on demand."""
+    data = {"a": [{"b": 1}, {"b": [2, 3]}]}
+    nodes = jsonpath24.query("$..b[1]", data)
+    assert len(nodes) == 1
+    assert nodes[0].location == ["a", 1, "b", 1]
+    assert nodes[0].path() == "$['a'][1]['b'][1]"
+
+
+def test_root_node_location() -> None:
+    """Test that the root node has an empty location."""
+    nodes = jsonpath24.query("$", {"a": 1})
+    assert nodes[0].location == []
+    assert nodes[0].path() == "$"
+
+
+def test_sibling_locations() -> None:
+    """Test that siblings sharing a parent have distinct locations."""
+    data = {"a": {"x": 1, "y": 2}}
+    assert [node.location for node in jsonpath24.query("$.a.*", data)] == [
+        ["a", "x"],
+        ["a", "y"],
+    ]
@@ -0,0 +1,59 @@
+import json
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+
+from jsonpath24 import JSONDocument
+from jsonpath24 import JSONPathEnvironment
+
+DATA = {
+    "limit": 500,
+    "items": [
+        {"id": i, "n": i * 0.5, "name": f"item{i % 7}", "tags": ["x"] * (i % 3)}
+        for i in range(3000)
+    ]
+    + [{"id": 2**70, "n": None, "name": True, "tags": {}}],
+}
+
+QUERIES = [
+    "$.items[*].id",
+    "$.items[10:2000:3].name",
+    "$.items[::-7].id",
+    "$.items[?@.id < 100 || @.name == 'item3'].id",
+    "$.items[?@.n >= 1000.5 && @.tags[1]]",
+    "$.items[?@.id > $.limit].tags[0]",
+    "$.items[?@.id == 1180591620717411303424].n",
+    "$.items[?length(@.tags) == 2].id",
+    "$.items[?@.id == 5]..*",
+    "$..items[?@.name == true]",
+]
+
+
+@pytest.mark.parametrize("query", QUERIES)
+def test_parallel_query(query: str) -> None:
+    """Test that parallel evaluation gives the same nodes, in the same order."""
+    doc = JSONDocument(json.dumps(DATA))
+    sequential = JSONPathEnvironment().query(query, doc)
+    env = JSONPathEnvironment(parallel_threshold=100, threads=4)
+    nodes = env.query(query, doc)
+    assert [node.path() for node in nodes] == [node.path() for node in sequential]
+    assert [node.value for node in nodes] == [node.value for node in sequential]
+    assert env.findall(query, doc) == [node.value for node in sequential]
+
+
+def test_parallel_matches_python_objects() -> None:
+    """Test that parallel document queries agree with querying Python objects."""
+    env = JSONPathEnvironment(parallel_threshold=1)
+    doc = JSONDocument(json.dumps(DATA))
+    for query in QUERIES:
+        assert env.findall(query, doc) == env.findall(query, DATA)
+
+
+def test_shared_thread_pool() -> None:
+    """Test that concurrent queries can share an environment's threads."""
+    env = JSONPathEnvironment(parallel_threshold=100, threads=4)
+    doc = JSONDocument(json.dumps(DATA))
+    want = [JSONPathEnvironment().findall(query, doc) for query in QUERIES]
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        got = list(executor.map(lambda q: env.findall(q, doc), QUERIES * 4))
+    assert got == want * 4
@@ -0,0 +1,46 @@
+from jsonpath24 import JSONPathEnvironment
+
+DATA = {
+    "meta": {"id": 7, "tags": ["a", "b"], "owner": {"name": "x"}},
+    "items": [{"price": 1}, {"price": 5}, {"price": 3}],
+}
+
+PATHS = [
+    "$.meta.id",
+    "$.meta.*",
+    "$.meta.tags[*]",
+    "$.meta..name",
+    "$.items[?@.price > 2].price",
+    "$.items[?@.price > 2]",
+    "$.missing.id",
+    "$",
+    "$.meta.id",
+]
+
+
+def test_query_set_matches_standalone_queries() -> None:
+    """Test that a query set gives the same results as separate queries."""
+    env = JSONPathEnvironment()
+    queries = env.query_set(PATHS)
+    assert len(queries) == len(PATHS)
+    assert queries.paths == PATHS
+    assert queries.findall(DATA) == [env.findall(path, DATA) for path in PATHS]
+
+    for path, nodes in zip(PATHS, queries.query(DATA)):
+        assert [node.path() for node in nodes] == [
+            node.path() for node in env.query(path, DATA)
+        ]
+
+
+def test_query_set_reuse() -> None:
+    """Test that a query set can be applied to many documents."""
+    env = JSONPathEnvironment()
+    queries = env.query_set(["$.a", "$.a.b", "$[0]"])
+    assert queries.findall({"a": {"b": 1}}) == [[{"b": 1}], [1], []]
+    assert queries.findall([1, 2]) == [[], [], [1]]
+
+
+def test_empty_query_set() -> None:
+    """Test that a query set can be empty."""
+    queries = JSONPathEnvironment().query_set([])
+    assert queries.findall({}) == []
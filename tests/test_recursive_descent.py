@@ -0,0 +1,21 @@
+from typing import List
+
+import jsonpath24
+
+
+def test_recursive_descent_order() -> None:
+    """Test that descendants are selected in document order."""
+    data = {"a": {"b": [1, {"b": 2}], "c": {"b": 3}}, "b": 4}
+    assert jsonpath24.findall("$..b", data) == [4, [1, {"b": 2}], 2, 3]
+
+
+def test_recursive_descent_deeply_nested() -> None:
+    """Test that deeply nested data does not overflow the native stack."""
+    depth = 100_000
+    data: List[object] = []
+    for _ in range(depth):
+        data = [data]
+
+    assert len(jsonpath24.findall("$..*", data)) == depth
+    assert sum(1 for _ in jsonpath24.finditer("$..[0]", data)) == depth
+    assert len(jsonpath24.query("$..*", data)[-1].location) == depth
@@ -0,0 +1,25 @@
+import jsonpath24
+
+
+def test_root_query_in_filter() -> None:
+    """Test that a root query in a filter is evaluated against the root."""
+    data = {"settings": {"threshold": 3}, "items": [{"price": p} for p in range(6)]}
+    assert jsonpath24.findall("$.items[?@.price > $.settings.threshold]", data) == [
+        {"price": 4},
+        {"price": 5},
+    ]
+
+
+def test_root_query_in_nested_filter() -> None:
+    """Test that `$` in a nested filter still refers to the document root."""
+    data = {"y": 1, "items": [{"x": [1], "y": 2}, {"x": [2], "y": 1}]}
+    assert jsonpath24.findall("$.items[?@.x[?@ == $.y]]", data) == [
+        {"x": [1], "y": 2}
+    ]
+
+
+def test_root_query_per_top_level_query() -> None:
+    """Test that root query results don't leak between top-level queries."""
+    path = jsonpath24.compile("$.items[?@ == $.want]")
+    assert path.findall({"want": 1, "items": [1, 2]}) == [1]
+    assert path.findall({"want": 2, "items": [1, 2]}) == [2]
@@ -0,0 +1,57 @@
+from typing import Any
+from typing import Dict
+from typing import List
+from typing import Union
+
+from jsonpath24 import ExpressionType
+from jsonpath24 import FilterFunction
+from jsonpath24 import JSONPathEnvironment
+
+
+class Upper(dict):  # type: ignore
+    def __getitem__(self, key: str) -> object:
+        return str(super().__getitem__(key)).upper()
+
+
+class Clear(FilterFunction):
+    arg_types = (ExpressionType.value,)
+    return_type = ExpressionType.logical
+
+    def __init__(self, data: Union[List[Any], Dict[str, Any]]) -> None:
+        self.data = data
+
+    def __call__(self, obj: object) -> bool:
+        self.data.clear()
+        return True
+
+
+def test_dict_subclass_name_selector() -> None:
+    """Test that dict subclasses are read with their own `__getitem__`."""
+    env = JSONPathEnvironment()
+    data = {"a": Upper(b="x"), "c": {"b": "y"}}
+    assert env.findall("$.*.b", data) == ["X", "y"]
+    assert [node.value for node in env.finditer("$.*.b", data)] == ["X", "y"]
+
+
+def test_names_are_shared_between_nodes() -> None:
+    """Test that one name selector selects from many dicts."""
+    env = JSONPathEnvironment()
+    data = [{"b": i, "a": -i} for i in range(100)]
+    assert env.findall("$[*].b", data) == list(range(100))
+    assert env.findall("$[?@.a < -97].a", data) == [-98, -99]
+
+
+def test_filter_function_clears_container() -> None:
+    """Test that candidates outlive a filter that removes them."""
+    env = JSONPathEnvironment()
+    for query in ("$[?clear(@)]", "$[?clear(@) && @[0] > 0]"):
+        for method in (env.query, env.finditer):
+            items: List[Any] = [[i + 1] for i in range(3)]
+            env.register_function("clear", Clear(items))
+            nodes = list(method(query, items))
+            assert [node.value for node in nodes] == [[1]]
+
+            mapping = {f"k{i}": [i + 1] for i in range(3)}
+            env.register_function("clear", Clear(mapping))
+            nodes = list(method(query, mapping))
+            assert [node.path() for node in nodes] == ["$['k0']"]
@@ -0,0 +1,49 @@
+from typing import List
+
+from jsonpath24 import ExpressionType
+from jsonpath24 import FilterFunction
+from jsonpath24 import JSONPathEnvironment
+
+
+class Spy(FilterFunction):
+    """A logical filter function that records its arguments."""
+
+    arg_types = (ExpressionType.value,)
+    return_type = ExpressionType.logical
+
+    def __init__(self) -> None:
+        self.calls: List[object] = []
+
+    def __call__(self, obj: object) -> bool:
+        self.calls.append(obj)
+        return True
+
+
+def test_logical_and_short_circuits() -> None:
+    """Test that the right side of `&&` is skipped when the left is false."""
+    env = JSONPathEnvironment()
+    spy = Spy()
+    env.register_function("spy", spy)
+    data = [{"a": 1}, {"b": 2}, {"a": 3}]
+    assert env.findall("$[?@.a && spy(@.a)]", data) == [{"a": 1}, {"a": 3}]
+    assert spy.calls == [1, 3]
+
+
+def test_logical_or_short_circuits() -> None:
+    """Test that the right side of `||` is skipped when the left is true."""
+    env = JSONPathEnvironment()
+    spy = Spy()
+    env.register_function("spy", spy)
+    data = [{"a": 1}, {"b": 2}]
+    assert env.findall("$[?@.a || spy(@.b)]", data) == data
+    assert spy.calls == [2]
+
+
+def test_existence_tests() -> None:
+    """Test existence tests, including those against single false values."""
+    env = JSONPathEnvironment()
+    data = [{"a": [1, 2]}, {"a": False}, {"b": 1}, {"a": {"x": 1, "y": 2}}]
+    assert env.findall("$[?@.a]", data) == [data[0], data[1], data[3]]
+    assert env.findall("$[?@.a.*]", data) == [data[0], data[3]]
+    assert env.findall("$[?!@.a]", data) == [data[2]]
+    assert env.findall("$[?@..x || @..y]", data) == [data[3]]
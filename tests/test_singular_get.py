@@ -0,0 +1,59 @@
+import jsonpath24
+from jsonpath24 import NOTHING
+from jsonpath24 import JSONPathEnvironment
+
+DATA = {"a": [{"b": 1}, {"b": None}], "c": {"d e": "x"}}
+
+
+def test_get_singular_query() -> None:
+    """Test that `get` returns the value at a singular query's location."""
+    env = JSONPathEnvironment()
+    assert env.get("$.a[0].b", DATA) == 1
+    assert env.get("$.a[-1].b", DATA) is None
+    assert env.get("$.c['d e']", DATA) == "x"
+    assert env.get("$", DATA) is DATA
+
+
+def test_get_missing() -> None:
+    """Test that `get` returns NOTHING when nothing matches."""
+    env = JSONPathEnvironment()
+    assert env.get("$.a[2].b", DATA) is NOTHING
+    assert env.get("$.a.b", DATA) is NOTHING
+    assert env.get("$.c[0]", DATA) is NOTHING
+    assert env.get("$.x.y", DATA) is NOTHING
+
+
+def test_get_non_singular_query() -> None:
+    """Test that `get` returns the first match of other queries."""
+    env = JSONPathEnvironment()
+    assert env.get("$.a[*].b", DATA) == 1
+    assert env.get("$..b", DATA) == 1
+    assert env.get("$.a[?@.b == 2]", DATA) is NOTHING
+
+
+def test_query_one() -> None:
+    """Test that `query_one` returns the first node and its location."""
+    node = jsonpath24.query_one("$.a[1].b", DATA)
+    assert node is not None
+    assert node.value is None
+    assert node.path() == "$['a'][1]['b']"
+    assert jsonpath24.query_one("$.a[5]", DATA) is None
+
+
+def test_compiled_get() -> None:
+    """Test `get` and `query_one` on compiled queries."""
+    path = jsonpath24.compile("$.c['d e']")
+    assert path.get(DATA) == "x"
+    assert path.get({}) is NOTHING
+    node = path.query_one(DATA)
+    assert node is not None
+    assert node.location == ["c", "d e"]
+
+
+def test_singular_filter_queries() -> None:
+    """Test singular queries in filters, including missing names."""
+    data = [{"x": {"y": 1}}, {"x": {"y": 2}}, {"x": 3}, {}]
+    env = JSONPathEnvironment()
+    assert env.findall("$[?@.x.y == 2]", data) == [{"x": {"y": 2}}]
+    assert env.findall("$[?@.x.y]", data) == [{"x": {"y": 1}}, {"x": {"y": 2}}]
+    assert env.findall("$[?@.x == $[2].x]", data) == [{"x": 3}]
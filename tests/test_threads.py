@@ -0,0 +1,88 @@
+import sys
+import sysconfig
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+
+from jsonpath24 import ExpressionType
+from jsonpath24 import FilterFunction
+from jsonpath24 import JSONPathEnvironment
+
+DATA = {"items": [{"id": i, "tags": ["a", "b"][: i % 3]} for i in range(200)]}
+
+QUERIES = [
+    ("$.items[?@.id > 190].id", list(range(191, 200))),
+    ("$.items[?count(@.tags[*]) == 2].id", list(range(2, 200, 3))),
+    ("$..tags[1]", ["b"] * len(range(2, 200, 3))),
+]
+
+
+class IsOne(FilterFunction):
+    """A logical filter function that is true for the number one."""
+
+    arg_types = (ExpressionType.value,)
+    return_type = ExpressionType.logical
+
+    def __call__(self, value: object) -> bool:
+        return value == 1
+
+
+def test_concurrent_queries() -> None:
+    """Test that threads sharing an environment and data get the same results."""
+    env = JSONPathEnvironment()
+
+    def work(_: int) -> None:
+        for _ in range(20):
+            for query, want in QUERIES:
+                assert env.findall(query, DATA) == want
+
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        list(executor.map(work, range(8)))
+
+
+def test_register_function_while_querying() -> None:
+    """Test that registering functions doesn't disturb queries in progress."""
+    env = JSONPathEnvironment()
+    env.register_function("is_one", IsOne())
+    stop = threading.Event()
+
+    def register() -> None:
+        while not stop.is_set():
+            env.register_function("is_one", IsOne())
+
+    registering = threading.Thread(target=register)
+    registering.start()
+    try:
+        for _ in range(200):
+            assert env.findall("$.items[?is_one(@.id)].id", DATA) == [1]
+    finally:
+        stop.set()
+        registering.join()
+
+
+def test_iterator_already_executing() -> None:
+    """Test that an iterator can't be advanced from inside its own filter."""
+    env = JSONPathEnvironment()
+    it = None
+
+    class Reenter(FilterFunction):
+        arg_types = (ExpressionType.value,)
+        return_type = ExpressionType.logical
+
+        def __call__(self, _: object) -> bool:
+            assert it is not None
+            next(it)
+            return True
+
+    env.register_function("reenter", Reenter())
+    it = env.finditer("$.items[?reenter(@.id)]", DATA)
+    with pytest.raises(ValueError, match="already executing"):
+        next(it)
+
+
+def test_module_declares_free_threading_support() -> None:
+    """Test that importing the extension doesn't re-enable the GIL."""
+    if not sysconfig.get_config_var("Py_GIL_DISABLED"):
+        pytest.skip("not a free-threaded build")
+    assert not sys._is_gil_enabled()  # type: ignore  # noqa: SLF001